@@ -6,139 +6,618 @@
 /*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/02/10 11:22:28 by igngonza          #+#    #+#             */
-/*   Updated: 2026/03/09 11:16:09 by igngonza         ###   ########.fr       */
+/*   Updated: 2026/10/18 02:58:53 by igngonza         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "BitcoinExchange.hpp"
+#include "MappedFile.hpp"
+#include "Profile.hpp"
+#include "RateSnapshot.hpp"
+#include <cctype>
+#include <cmath>
 #include <cstdlib>
-#include <fstream>
+#include <cstring>
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
 #include <iostream>
-#include <sstream>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-BitcoinExchange::BitcoinExchange() {}
+// Lines are split and their dates parsed this many at a time
+static const size_t g_blockSize = 256;
+// Input is cut into chunks of about this size at line boundaries
+static const size_t g_chunkSize = 1 << 20;
+// How many chunks each worker may run ahead of the writer
+static const size_t g_chunksPerWorker = 4;
+
+BitcoinExchange::BitcoinExchange() : workers(1), quiet(false) {
+  source.offset = 0;
+  source.tail = 0;
+  source.size = 0;
+  source.inode = 0;
+  source.mtimeSec = 0;
+  source.mtimeNsec = 0;
+}
 
 BitcoinExchange::BitcoinExchange(const BitcoinExchange &other)
-    : database(other.database) {}
+    : database(other.database), source(other.source),
+      workers(other.workers), quiet(other.quiet) {}
 
 BitcoinExchange &BitcoinExchange::operator=(const BitcoinExchange &other) {
-  if (this != &other)
+  if (this != &other) {
     database = other.database;
+    source = other.source;
+    workers = other.workers;
+    quiet = other.quiet;
+  }
   return (*this);
 }
 
 BitcoinExchange::~BitcoinExchange() {}
 
+// 0 picks one worker per online CPU
+void BitcoinExchange::setWorkers(size_t count) {
+  long cpus;
+
+  if (count == 0) {
+    cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    count = cpus > 0 ? static_cast<size_t>(cpus) : 1;
+  }
+  this->workers = count;
+}
+
+// Per-line error messages are dropped; the counts in Profile are kept
+void BitcoinExchange::setQuiet(bool enabled) { this->quiet = enabled; }
+
 void BitcoinExchange::loadDatabase(const std::string &filename) {
-  std::ifstream file(filename.c_str());
-  if (!file.is_open())
+  uint64_t start;
+
+  start = Profile::now();
+  if (RateSnapshot::load(this->database, filename))
+    recordSource(filename, std::string::npos);
+  else
+    parseDatabase(filename);
+  Profile::add(Profile::LOAD, Profile::now() - start);
+}
+
+void BitcoinExchange::saveSnapshot(const std::string &filename) {
+  parseDatabase(filename);
+  if (!this->database.getTicks().empty())
+    throw std::runtime_error("Error: snapshots only hold daily rates");
+  if (!RateSnapshot::save(this->database, filename))
+    throw std::runtime_error("Error: could not write the snapshot file");
+}
+
+void BitcoinExchange::parseDatabase(const std::string &filename) {
+  MappedFile file;
+  OutputBuffer errors;
+  const char *eol;
+
+  this->database.clear();
+  if (this->quiet)
+    errors.mute(STDERR_FILENO);
+  if (!file.open(filename))
     throw std::runtime_error("Error: could not open the database file");
-  std::string line;
-  if (!std::getline(file, line))
+  if (file.size() == 0)
     throw std::runtime_error("Error: empty database file");
-  while (std::getline(file, line)) {
-    if (line.empty())
-      continue;
-    parseDatabaseLine(line);
+  parseRows(file.data(), file.data() + file.size(), true, this->database,
+            errors);
+  this->database.finalize();
+  errors.flush();
+  eol = static_cast<const char *>(memrchr(file.data(), '\n', file.size()));
+  recordSource(filename, eol ? eol + 1 - file.data() : 0);
+}
+
+// Remembers how far the database file has been read, npos when it was
+// not read at all, so a reload only has to look at what was appended since
+void BitcoinExchange::recordSource(const std::string &filename,
+                                   size_t offset) {
+  struct stat st;
+
+  this->source.file = filename;
+  this->source.offset = offset;
+  this->source.tail = 0;
+  this->source.size = 0;
+  this->source.inode = 0;
+  this->source.mtimeSec = 0;
+  this->source.mtimeNsec = 0;
+  if (stat(filename.c_str(), &st) != 0)
+    return;
+  this->source.size = st.st_size;
+  this->source.inode = st.st_ino;
+  this->source.mtimeSec = st.st_mtim.tv_sec;
+  this->source.mtimeNsec = st.st_mtim.tv_nsec;
+}
+
+// Rows between begin and end; the first line is skipped as the header.
+// Rows are split a block at a time, then their dates are parsed one after
+// the other before any row is added.
+void BitcoinExchange::parseRows(const char *begin, const char *end,
+                                bool header, RateTable &table,
+                                OutputBuffer &errors) {
+  Row rows[g_blockSize];
+  const char *dates[g_blockSize];
+  size_t lengths[g_blockSize];
+  int days[g_blockSize];
+  unsigned char valid[g_blockSize];
+  uint64_t tally[Profile::COUNTERS] = {0};
+  const char *eol;
+  size_t count;
+
+  if (header) {
+    eol = static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+    begin = eol ? eol + 1 : end;
+  }
+  while (begin < end) {
+    count = 0;
+    while (count < g_blockSize && begin < end) {
+      eol = static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+      if (!eol)
+        eol = end;
+      if (eol != begin) {
+        splitRow(begin, eol - begin, rows[count]);
+        dates[count] = rows[count].date;
+        lengths[count] = rows[count].dateLen;
+        ++count;
+      }
+      begin = eol + 1;
+    }
+    parseDates(dates, lengths, count, end, days, valid);
+    for (size_t i = 0; i < count; ++i)
+      ++tally[addRow(rows[i], valid[i], days[i], table, errors)];
   }
-  file.close();
+  for (int i = Profile::ROWS_OK; i <= Profile::ROWS_BAD_RATE; ++i)
+    Profile::count(static_cast<Profile::Counter>(i), tally[i]);
 }
 
 void BitcoinExchange::processInput(const std::string &filename) {
-  std::ifstream file(filename.c_str());
-  if (!file.is_open()) {
+  MappedFile file;
+  const char *body;
+  const char *end;
+  const char *eol;
+
+  if (!file.open(filename)) {
     std::cerr << "Error: could not open the input file" << std::endl;
     return;
   }
-  std::string line;
-  if (!std::getline(file, line)) {
+  if (file.size() == 0) {
     std::cerr << "Error: empty input file" << std::endl;
     return;
   }
-  std::string header = trim(line);
+  end = file.data() + file.size();
+  eol = static_cast<const char *>(
+      std::memchr(file.data(), '\n', file.size()));
+  if (!eol)
+    eol = end;
+  std::string header = trim(std::string(file.data(), eol - file.data()));
   if (header != "date | value") {
     std::cerr << "Error: invalid header format (expected 'date | value')"
               << std::endl;
     return;
   }
-  while (std::getline(file, line)) {
-    if (line.empty())
-      continue;
-    parseInputLine(line);
+  body = eol < end ? eol + 1 : end;
+  if (this->workers <= 1)
+    processSequential(body, end);
+  else
+    processParallel(body, end);
+}
+
+// Chunk boundaries, each one just past a newline (or at the end)
+static std::vector<const char *> splitChunks(const char *begin,
+                                             const char *end) {
+  std::vector<const char *> bounds;
+  const char *cut;
+
+  bounds.push_back(begin);
+  while (static_cast<size_t>(end - bounds.back()) > g_chunkSize) {
+    cut = static_cast<const char *>(std::memchr(
+        bounds.back() + g_chunkSize, '\n', end - bounds.back() - g_chunkSize));
+    if (!cut)
+      break;
+    bounds.push_back(cut + 1);
   }
-  file.close();
+  if (bounds.back() != end)
+    bounds.push_back(end);
+  return (bounds);
 }
 
-void BitcoinExchange::parseDatabaseLine(const std::string &line) {
-  size_t pos;
-  double rate;
+void BitcoinExchange::processSequential(const char *begin,
+                                        const char *end) const {
+  std::vector<const char *> bounds = splitChunks(begin, end);
+  OutputBuffer out;
+  uint64_t start;
 
-  pos = line.find(',');
-  if (pos == std::string::npos) {
-    std::cerr << "Error: bad database line: " << line << std::endl;
-    return;
+  if (this->quiet)
+    out.mute(STDERR_FILENO);
+  for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+    processChunk(bounds[i], bounds[i + 1], out);
+    start = Profile::now();
+    out.flush();
+    Profile::add(Profile::OUTPUT, Profile::now() - start);
   }
-  std::string date = trim(line.substr(0, pos));
-  std::string value = trim(line.substr(pos + 1));
-  if (!validateDate(date)) {
-    std::cerr << "Error: invalid date => " << date << std::endl;
-    return;
+}
+
+struct Pipeline {
+  const BitcoinExchange *btc;
+  std::vector<const char *> bounds;
+  std::vector<OutputBuffer> slots;
+  std::vector<bool> ready;
+  size_t chunks;
+  size_t nextChunk;
+  size_t nextWrite;
+  pthread_mutex_t lock;
+  pthread_cond_t chunkDone;
+  pthread_cond_t slotFree;
+};
+
+// Workers claim chunks in order but never more than slots.size() ahead of
+// the writer, which bounds the memory held by pending output
+void *BitcoinExchange::runWorker(void *arg) {
+  Pipeline *p;
+  size_t chunk;
+  size_t slot;
+
+  p = static_cast<Pipeline *>(arg);
+  pthread_mutex_lock(&p->lock);
+  while (true) {
+    while (p->nextChunk < p->chunks &&
+           p->nextChunk >= p->nextWrite + p->slots.size())
+      pthread_cond_wait(&p->slotFree, &p->lock);
+    if (p->nextChunk >= p->chunks)
+      break;
+    chunk = p->nextChunk++;
+    slot = chunk % p->slots.size();
+    pthread_mutex_unlock(&p->lock);
+    p->btc->processChunk(p->bounds[chunk], p->bounds[chunk + 1],
+                         p->slots[slot]);
+    pthread_mutex_lock(&p->lock);
+    p->ready[slot] = true;
+    pthread_cond_broadcast(&p->chunkDone);
   }
-  rate = 0.0;
-  std::stringstream ss(value);
-  if (!(ss >> rate) || rate < 0) {
-    std::cerr << "Error: invalid rate => " << value << std::endl;
+  pthread_mutex_unlock(&p->lock);
+  return (NULL);
+}
+
+void BitcoinExchange::processParallel(const char *begin,
+                                      const char *end) const {
+  Pipeline p;
+  std::vector<pthread_t> threads(this->workers);
+  size_t started;
+  size_t slot;
+  uint64_t start;
+
+  p.btc = this;
+  p.bounds = splitChunks(begin, end);
+  p.chunks = p.bounds.size() - 1;
+  p.slots.resize(this->workers * g_chunksPerWorker);
+  p.ready.resize(p.slots.size(), false);
+  for (size_t i = 0; this->quiet && i < p.slots.size(); ++i)
+    p.slots[i].mute(STDERR_FILENO);
+  p.nextChunk = 0;
+  p.nextWrite = 0;
+  pthread_mutex_init(&p.lock, NULL);
+  pthread_cond_init(&p.chunkDone, NULL);
+  pthread_cond_init(&p.slotFree, NULL);
+  started = 0;
+  while (started < threads.size() &&
+         pthread_create(&threads[started], NULL, runWorker, &p) == 0)
+    ++started;
+  // Running the workers' loop here would stall once it got slots.size()
+  // chunks ahead of a writer that never runs, so go sequential instead
+  if (started == 0) {
+    pthread_cond_destroy(&p.slotFree);
+    pthread_cond_destroy(&p.chunkDone);
+    pthread_mutex_destroy(&p.lock);
+    processSequential(begin, end);
     return;
   }
-  this->database[date] = rate;
+  for (size_t chunk = 0; chunk < p.chunks; ++chunk) {
+    slot = chunk % p.slots.size();
+    pthread_mutex_lock(&p.lock);
+    while (!p.ready[slot])
+      pthread_cond_wait(&p.chunkDone, &p.lock);
+    pthread_mutex_unlock(&p.lock);
+    start = Profile::now();
+    p.slots[slot].flush();
+    Profile::add(Profile::OUTPUT, Profile::now() - start);
+    pthread_mutex_lock(&p.lock);
+    p.ready[slot] = false;
+    ++p.nextWrite;
+    pthread_cond_broadcast(&p.slotFree);
+    pthread_mutex_unlock(&p.lock);
+  }
+  for (size_t i = 0; i < started; ++i)
+    pthread_join(threads[i], NULL);
+  pthread_cond_destroy(&p.slotFree);
+  pthread_cond_destroy(&p.chunkDone);
+  pthread_mutex_destroy(&p.lock);
 }
 
-void BitcoinExchange::parseInputLine(const std::string &line) {
-  size_t pos;
-  double valueD;
-  double rate;
-  double result;
+void BitcoinExchange::processChunk(const char *begin, const char *end,
+                                   OutputBuffer &out) const {
+  Query queries[g_blockSize];
+  const char *dates[g_blockSize];
+  size_t lengths[g_blockSize];
+  int days[g_blockSize];
+  unsigned char valid[g_blockSize];
+  bool split[g_blockSize];
+  QueryStatus status[g_blockSize];
+  uint64_t tally[Profile::COUNTERS] = {0};
+  const char *eol;
+  RateTable::Cursor cursor;
+  size_t count;
+  uint64_t parsed;
+  uint64_t found;
+  uint64_t stamp;
 
-  pos = line.find('|');
-  if (pos == std::string::npos) {
-    std::cerr << "Error: bad input => " << line << std::endl;
-    return;
+  stamp = Profile::now();
+  while (begin < end) {
+    count = 0;
+    while (count < g_blockSize && begin < end) {
+      eol = static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+      if (!eol)
+        eol = end;
+      if (eol != begin) {
+        split[count] = splitQuery(begin, eol - begin, false, queries[count]);
+        dates[count] = queries[count].date;
+        lengths[count] = queries[count].dateLen;
+        ++count;
+      }
+      begin = eol + 1;
+    }
+    parseDates(dates, lengths, count, end, days, valid);
+    for (size_t i = 0; i < count; ++i) {
+      queries[i].day = days[i];
+      status[i] =
+          split[i] ? checkQuery(queries[i], valid[i]) : QUERY_BAD_INPUT;
+    }
+    parsed = Profile::now();
+    for (size_t i = 0; i < count; ++i) {
+      if (status[i] == QUERY_OK)
+        status[i] = lookupQuery(queries[i], this->database, cursor);
+      ++tally[status[i]];
+    }
+    found = Profile::now();
+    for (size_t i = 0; i < count; ++i)
+      formatQuery(queries[i], status[i], out);
+    Profile::add(Profile::PARSE, parsed - stamp);
+    Profile::add(Profile::LOOKUP, found - parsed);
+    stamp = Profile::now();
+    Profile::add(Profile::OUTPUT, stamp - found);
   }
-  std::string date = trim(line.substr(0, pos));
-  std::string value = trim(line.substr(pos + 1));
-  if (!validateDate(date)) {
-    std::cerr << "Error: bad input => " << line << std::endl;
-    return;
+  for (int i = Profile::LINES_OK; i <= Profile::LINES_NO_RATE; ++i)
+    Profile::count(static_cast<Profile::Counter>(i), tally[i]);
+}
+
+// A `YYYY-MM-DD HH:MM:SS` field is cut down to its date, with time
+// pointing at the HH:MM:SS part; time is NULL for any other field
+static void splitTimestamp(const char *date, size_t &len, const char *&time) {
+  time = NULL;
+  if (len == 19 && date[10] == ' ') {
+    time = date + 11;
+    len = 10;
   }
-  valueD = 0.0;
-  std::stringstream ss(value);
-  if (!(ss >> valueD) || !ss.eof()) {
-    std::cerr << "Error: bad input => " << line << std::endl;
-    return;
+}
+
+void BitcoinExchange::splitRow(const char *line, size_t len, Row &row) {
+  const char *dateEnd;
+
+  row.line = line;
+  row.len = len;
+  row.comma = static_cast<const char *>(std::memchr(line, ',', len));
+  row.date = line;
+  row.dateLen = 0;
+  row.time = NULL;
+  if (row.comma) {
+    dateEnd = row.comma;
+    trim(row.date, dateEnd);
+    row.dateLen = dateEnd - row.date;
+    splitTimestamp(row.date, row.dateLen, row.time);
   }
-  if (valueD < 0) {
-    std::cerr << "Error: not a positive number." << std::endl;
-    return;
+}
+
+// Adds the row to table, or reports it; returns the row's outcome
+Profile::Counter BitcoinExchange::addRow(const Row &row, bool dateOk, int day,
+                                         RateTable &table,
+                                         OutputBuffer &errors) {
+  const char *value;
+  const char *valueEnd;
+  double rate;
+  int seconds;
+
+  errors.setStream(STDERR_FILENO);
+  if (!row.comma) {
+    errors.append("Error: bad database line: ");
+    errors.append(row.line, row.len);
+    errors.endLine();
+    return (Profile::ROWS_BAD_LINE);
   }
-  if (valueD > 1000) {
-    std::cerr << "Error: too large a number." << std::endl;
-    return;
+  seconds = 0;
+  if (!dateOk || (row.time && !parseTime(row.time, seconds))) {
+    errors.append("Error: invalid date => ");
+    errors.append(row.date, row.time ? row.time + 8 - row.date : row.dateLen);
+    errors.endLine();
+    return (Profile::ROWS_BAD_DATE);
   }
-  std::map<std::string, double>::iterator it = this->database.lower_bound(date);
+  value = row.comma + 1;
+  valueEnd = row.line + row.len;
+  trim(value, valueEnd);
   rate = 0.0;
-  if (it != this->database.end() && date == it->first)
-    rate = it->second;
-  else {
-    if (it == this->database.begin()) {
-      std::cerr << "Error: no earlier rate available for the date " << date
-                << std::endl;
-      return;
+  if (parseDouble(value, valueEnd - value, rate) == 0 || rate < 0) {
+    errors.append("Error: invalid rate => ");
+    errors.append(value, valueEnd - value);
+    errors.endLine();
+    return (Profile::ROWS_BAD_RATE);
+  }
+  if (row.time)
+    table.insertTick(day, seconds, rate);
+  else
+    table.insert(day, rate);
+  return (Profile::ROWS_OK);
+}
+
+// Trimmed fields of a `date | value` or `start..end | value` line, where
+// date may carry a time of day. False when there is no '|', unless
+// bareDate allows a line holding only a date or range (a rate query).
+bool BitcoinExchange::splitQuery(const char *line, size_t len, bool bareDate,
+                                 Query &q) {
+  const char *bar;
+  const char *dateEnd;
+  const char *dots;
+  const char *valueEnd;
+
+  bar = static_cast<const char *>(std::memchr(line, '|', len));
+  q.line = line;
+  q.len = len;
+  q.date = line;
+  dateEnd = bar ? bar : line + len;
+  q.lastDate = NULL;
+  q.lastDateLen = 0;
+  dots = static_cast<const char *>(std::memchr(line, '.', dateEnd - line));
+  if (dots && dots + 1 < dateEnd && dots[1] == '.') {
+    q.lastDate = dots + 2;
+    valueEnd = dateEnd;
+    trim(q.lastDate, valueEnd);
+    q.lastDateLen = valueEnd - q.lastDate;
+    dateEnd = dots;
+  }
+  trim(q.date, dateEnd);
+  q.dateLen = dateEnd - q.date;
+  q.time = NULL;
+  if (!q.lastDate)
+    splitTimestamp(q.date, q.dateLen, q.time);
+  q.seconds = 0;
+  q.value = NULL;
+  q.valueLen = 0;
+  q.amount = 1.0;
+  q.rate = 0.0;
+  if (bar) {
+    q.value = bar + 1;
+    valueEnd = line + len;
+    trim(q.value, valueEnd);
+    q.valueLen = valueEnd - q.value;
+  }
+  return (bar || bareDate);
+}
+
+// Parses the rest of q once its date is in q.day: the time, a range's end
+// date and the value. QUERY_OK means the query is ready for lookupQuery.
+BitcoinExchange::QueryStatus BitcoinExchange::checkQuery(Query &q,
+                                                         bool dateOk) {
+  if (!dateOk || (q.time && !parseTime(q.time, q.seconds)))
+    return (QUERY_BAD_INPUT);
+  if (q.lastDate && (!parseDate(q.lastDate, q.lastDateLen, q.lastDay) ||
+                     q.lastDay < q.day))
+    return (QUERY_BAD_INPUT);
+  if (q.value) {
+    q.amount = 0.0;
+    if (q.valueLen == 0 || parseDouble(q.value, q.valueLen, q.amount) !=
+                               q.valueLen)
+      return (QUERY_BAD_INPUT);
+    if (q.amount < 0)
+      return (QUERY_NEGATIVE);
+    if (q.amount > 1000)
+      return (QUERY_TOO_LARGE);
+  }
+  return (QUERY_OK);
+}
+
+// Rate for a checked query; a range takes the average over its days
+BitcoinExchange::QueryStatus
+BitcoinExchange::lookupQuery(Query &q, const RateTable &table,
+                             RateTable::Cursor &cursor) {
+  if (q.lastDate) {
+    if (!table.aggregate(q.day, q.lastDay, q.rate, q.low, q.high))
+      return (QUERY_NO_RATE);
+    return (QUERY_OK);
+  }
+  if (q.time ? !table.findAt(q.day, q.seconds, q.rate)
+             : !table.find(q.day, q.rate, cursor))
+    return (QUERY_NO_RATE);
+  return (QUERY_OK);
+}
+
+BitcoinExchange::QueryStatus
+BitcoinExchange::finishQuery(Query &q, bool dateOk, const RateTable &table,
+                             RateTable::Cursor &cursor) {
+  QueryStatus status;
+
+  status = checkQuery(q, dateOk);
+  if (status != QUERY_OK)
+    return (status);
+  return (lookupQuery(q, table, cursor));
+}
+
+// Parses one line and looks its date up in table; see splitQuery
+BitcoinExchange::QueryStatus
+BitcoinExchange::evaluateQuery(const char *line, size_t len,
+                               const RateTable &table,
+                               RateTable::Cursor &cursor, bool bareDate,
+                               Query &q) {
+  if (!splitQuery(line, len, bareDate, q))
+    return (QUERY_BAD_INPUT);
+  return (finishQuery(q, parseDate(q.date, q.dateLen, q.day), table, cursor));
+}
+
+void BitcoinExchange::formatQuery(const Query &q, QueryStatus status,
+                                  OutputBuffer &out) {
+  if (status == QUERY_OK) {
+    out.setStream(STDOUT_FILENO);
+    out.append(q.date, q.time ? q.time + 8 - q.date : q.dateLen);
+    if (q.lastDate) {
+      out.append("..");
+      out.append(q.lastDate, q.lastDateLen);
+    }
+    out.append(" => ");
+    out.append(q.value, q.valueLen);
+    out.append(" = ");
+    out.appendDouble(q.amount * q.rate);
+    if (q.lastDate) {
+      out.append(" (avg ");
+      out.appendDouble(q.rate);
+      out.append(", min ");
+      out.appendDouble(q.low);
+      out.append(", max ");
+      out.appendDouble(q.high);
+      out.append(")");
     }
-    --it;
-    rate = it->second;
+    out.endLine();
+    return;
+  }
+  if (out.muted(STDERR_FILENO))
+    return;
+  out.setStream(STDERR_FILENO);
+  switch (status) {
+  case QUERY_BAD_INPUT:
+    out.append("Error: bad input => ");
+    out.append(q.line, q.len);
+    break;
+  case QUERY_NEGATIVE:
+    out.append("Error: not a positive number.");
+    break;
+  case QUERY_TOO_LARGE:
+    out.append("Error: too large a number.");
+    break;
+  default:
+    out.append("Error: no earlier rate available for the date ");
+    out.append(q.date, q.time ? q.time + 8 - q.date : q.dateLen);
+    break;
   }
-  result = valueD * rate;
-  std::cout << date << " => " << value << " = " << result << std::endl;
+  out.endLine();
+}
+
+void BitcoinExchange::parseInputLine(const char *line, size_t len,
+                                     const RateTable &table, OutputBuffer &out,
+                                     RateTable::Cursor &cursor) {
+  QueryStatus status;
+  Query q;
+
+  status = evaluateQuery(line, len, table, cursor, false, q);
+  Profile::count(static_cast<Profile::Counter>(status), 1);
+  formatQuery(q, status, out);
 }
 
 std::string BitcoinExchange::trim(const std::string &line) {
@@ -152,43 +631,231 @@ std::string BitcoinExchange::trim(const std::string &line) {
   return (line.substr(start, end - start + 1));
 }
 
-bool BitcoinExchange::validateDate(const std::string &date) const {
-  if (date.size() != 10)
+void BitcoinExchange::trim(const char *&begin, const char *&end) {
+  while (begin < end && (*begin == ' ' || *begin == '\t'))
+    ++begin;
+  while (end > begin && (end[-1] == ' ' || end[-1] == '\t'))
+    --end;
+}
+
+static const int g_daysInMonth[] = {31, 28, 31, 30, 31, 30,
+                                    31, 31, 30, 31, 30, 31};
+
+// Fields of a YYYY-MM-DD string, checking only its shape. avail is how many
+// bytes may be read from str, at least the 10 of the date.
+static bool splitDate(const char *str, size_t avail, int &year, int &month,
+                      int &mday) {
+#ifdef __SSE2__
+  char bytes[16];
+  __m128i raw;
+  __m128i digits;
+  __m128i fields;
+
+  // Load 16 bytes straight from str only when they are all readable;
+  // otherwise go through a copy of the date
+  if (avail >= 16)
+    raw = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str));
+  else {
+    std::memset(bytes, 0, sizeof(bytes));
+    std::memcpy(bytes, str, 10);
+    raw = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes));
+  }
+  digits = _mm_sub_epi8(raw, _mm_set1_epi8('0'));
+  // Unsigned byte <= 9 is a digit; bytes 4 and 7 must be dashes
+  if ((_mm_movemask_epi8(_mm_cmpeq_epi8(
+           _mm_max_epu8(digits, _mm_set1_epi8(9)), _mm_set1_epi8(9))) &
+       0x3ff) != 0x36f ||
+      (_mm_movemask_epi8(_mm_cmpeq_epi8(raw, _mm_set1_epi8('-'))) & 0x90) !=
+          0x90)
     return (false);
-  if (date[4] != '-' || date[7] != '-')
+  // Widen to 16 bits and weigh the digits with pmaddwd, giving the two
+  // halves of the year, of the month and the day; one more pass over the
+  // packed halves adds them up: lanes 0, 1 and 2 hold year, month, day
+  fields = _mm_packs_epi32(
+      _mm_madd_epi16(_mm_unpacklo_epi8(digits, _mm_setzero_si128()),
+                     _mm_set_epi16(0, 1, 10, 0, 1, 10, 100, 1000)),
+      _mm_madd_epi16(_mm_unpackhi_epi8(digits, _mm_setzero_si128()),
+                     _mm_set_epi16(0, 0, 0, 0, 0, 0, 1, 10)));
+  fields = _mm_madd_epi16(fields, _mm_set1_epi16(1));
+  year = _mm_cvtsi128_si32(fields);
+  month = _mm_extract_epi16(fields, 2);
+  mday = _mm_extract_epi16(fields, 4);
+  return (true);
+#else
+  static const size_t digitPos[] = {0, 1, 2, 3, 5, 6, 8, 9};
+  unsigned int d[8];
+
+  (void)avail;
+  if (str[4] != '-' || str[7] != '-')
     return (false);
-  for (size_t i = 0; i < date.size(); ++i) {
-    if (i == 4 || i == 7)
-      continue;
-    if (date[i] < '0' || date[i] > '9')
+  for (size_t i = 0; i < 8; ++i) {
+    d[i] = static_cast<unsigned char>(str[digitPos[i]]) - '0';
+    if (d[i] > 9)
       return (false);
   }
+  year = d[0] * 1000 + d[1] * 100 + d[2] * 10 + d[3];
+  month = d[4] * 10 + d[5];
+  mday = d[6] * 10 + d[7];
+  return (true);
+#endif
+}
 
-  int year = std::atoi(date.substr(0, 4).c_str());
-  int month = std::atoi(date.substr(5, 2).c_str());
-  int day = std::atoi(date.substr(8, 2).c_str());
+// Calendar check, then the count of days since 1970-01-01 (proleptic
+// Gregorian)
+static bool dayNumber(int year, int month, int mday, int &day) {
+  int era;
+  unsigned int yoe;
+  unsigned int doy;
 
-  if (month < 1 || month > 12)
-    return (false);
-  if (day < 1)
+  if (month < 1 || month > 12 || mday < 1)
     return (false);
-
-  bool isLeapYear = false;
-  if (year % 4 == 0) {
-    if (year % 100 == 0) {
-      if (year % 400 == 0)
-        isLeapYear = true;
-    } else
-      isLeapYear = true;
+  if (mday > g_daysInMonth[month - 1]) {
+    if (month != 2 || mday != 29)
+      return (false);
+    if (year % 4 != 0 || (year % 100 == 0 && year % 400 != 0))
+      return (false);
   }
+  if (month <= 2)
+    --year;
+  era = (year >= 0 ? year : year - 399) / 400;
+  yoe = static_cast<unsigned int>(year - era * 400);
+  doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + mday - 1;
+  day = era * 146097 + static_cast<int>(yoe * 365 + yoe / 4 - yoe / 100 + doy) -
+        719468;
+  return (true);
+}
 
-  int daysInMonth[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+// YYYY-MM-DD to a day number
+bool BitcoinExchange::parseDate(const char *str, size_t len, int &day) {
+  int year;
+  int month;
+  int mday;
 
-  if (isLeapYear)
-    daysInMonth[1] = 29;
+  return (len == 10 && splitDate(str, len, year, month, mday) &&
+          dayNumber(year, month, mday, day));
+}
 
-  if (day > daysInMonth[month - 1])
-    return (false);
+// HH:MM:SS to seconds since midnight
+bool BitcoinExchange::parseTime(const char *str, int &seconds) {
+  static const size_t digitPos[] = {0, 1, 3, 4, 6, 7};
+  unsigned int d[6];
 
+  if (str[2] != ':' || str[5] != ':')
+    return (false);
+  for (size_t i = 0; i < 6; ++i) {
+    d[i] = static_cast<unsigned char>(str[digitPos[i]]) - '0';
+    if (d[i] > 9)
+      return (false);
+  }
+  if (d[0] * 10 + d[1] > 23 || d[2] > 5 || d[4] > 5)
+    return (false);
+  seconds = (d[0] * 10 + d[1]) * 3600 + (d[2] * 10 + d[3]) * 60 + d[4] * 10 +
+            d[5];
   return (true);
 }
+
+// parseDate on each of count dates, all inside a buffer ending at end:
+// valid[i] tells whether dates[i] (of lengths[i] bytes) is a date, and
+// days[i] holds its day number when it is
+void BitcoinExchange::parseDates(const char *const *dates,
+                                 const size_t *lengths, size_t count,
+                                 const char *end, int *days,
+                                 unsigned char *valid) {
+  int year;
+  int month;
+  int mday;
+
+  for (size_t i = 0; i < count; ++i) {
+    days[i] = 0;
+    valid[i] = lengths[i] == 10 &&
+               splitDate(dates[i], end - dates[i], year, month, mday) &&
+               dayNumber(year, month, mday, days[i]);
+  }
+}
+
+// Same acceptance rules as `std::istream >> double`: the longest prefix that
+// looks like [+-]digits[.digits][(e|E)[+-]digits] must convert as a whole.
+// Returns the number of characters consumed, or 0 on failure.
+size_t BitcoinExchange::parseDouble(const char *str, size_t len,
+                                    double &value) {
+  static const double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                 1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                 1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                 1e18, 1e19, 1e20, 1e21, 1e22};
+  size_t i;
+  size_t start;
+  bool negative;
+  bool mantissa;
+  bool dot;
+  int digits;
+  int exp10;
+  int expValue;
+  bool expNegative;
+  unsigned long long m;
+
+  i = 0;
+  while (i < len && std::isspace(static_cast<unsigned char>(str[i])))
+    ++i;
+  start = i;
+  negative = false;
+  if (i < len && (str[i] == '+' || str[i] == '-'))
+    negative = (str[i++] == '-');
+  mantissa = false;
+  dot = false;
+  digits = 0;
+  exp10 = 0;
+  m = 0;
+  for (; i < len; ++i) {
+    if (str[i] >= '0' && str[i] <= '9') {
+      mantissa = true;
+      if (m == 0 && str[i] == '0') {
+        if (dot)
+          --exp10;
+        continue;
+      }
+      if (digits < 19) {
+        m = m * 10 + (str[i] - '0');
+        ++digits;
+        if (dot)
+          --exp10;
+      } else {
+        digits = 20;
+        if (!dot)
+          ++exp10;
+      }
+    } else if (str[i] == '.' && !dot)
+      dot = true;
+    else
+      break;
+  }
+  if (!mantissa)
+    return (0);
+  if (i < len && (str[i] == 'e' || str[i] == 'E')) {
+    ++i;
+    expNegative = false;
+    if (i < len && (str[i] == '+' || str[i] == '-'))
+      expNegative = (str[i++] == '-');
+    if (i == len || str[i] < '0' || str[i] > '9')
+      return (0);
+    expValue = 0;
+    for (; i < len && str[i] >= '0' && str[i] <= '9'; ++i) {
+      if (expValue < 100000)
+        expValue = expValue * 10 + (str[i] - '0');
+    }
+    exp10 += expNegative ? -expValue : expValue;
+  }
+  if (digits <= 19 && m < (1ULL << 53) && exp10 >= -22 && exp10 <= 22) {
+    value = static_cast<double>(m);
+    value = exp10 < 0 ? value / pow10[-exp10] : value * pow10[exp10];
+  } else {
+    // Out of the exact fast path: hand the collected text to strtod
+    std::string text(str + start, i - start);
+    value = std::strtod(text.c_str(), NULL);
+    if (value == HUGE_VAL || value == -HUGE_VAL)
+      return (0);
+    return (i);
+  }
+  if (negative)
+    value = -value;
+  return (i);
+}
@@ -6,14 +6,21 @@
 /*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/02/10 11:22:33 by igngonza          #+#    #+#             */
-/*   Updated: 2026/03/04 11:08:00 by igngonza         ###   ########.fr       */
+/*   Updated: 2026/10/18 02:58:53 by igngonza         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef BITCOIN_EXCHANGE__HPP
 # define BITCOIN_EXCHANGE__HPP
-# include <map>
+# include "MappedFile.hpp"
+# include "OutputBuffer.hpp"
+# include "Profile.hpp"
+# include "RateTable.hpp"
+# include <cstddef>
+# include <ctime>
+# include <stdint.h>
 # include <string>
+# include <sys/types.h>
 class BitcoinExchange
 {
   public:
@@ -22,17 +29,119 @@ class BitcoinExchange
 	BitcoinExchange &operator=(const BitcoinExchange &other);
 	~BitcoinExchange();
 
+	void setWorkers(size_t count);
+	void setQuiet(bool enabled);
 	void loadDatabase(const std::string &filename);
+	void saveSnapshot(const std::string &filename);
 	void processInput(const std::string &filename);
+	void streamInput(const std::string &filename);
+	void serve(const std::string &path);
 
   private:
-	std::map<std::string, double> database;
+	// Same order as the Profile::LINES_* counters
+	enum QueryStatus
+	{
+		QUERY_OK,
+		QUERY_BAD_INPUT,
+		QUERY_NEGATIVE,
+		QUERY_TOO_LARGE,
+		QUERY_NO_RATE
+	};
 
-	void parseDatabaseLine(const std::string &line);
-	void parseInputLine(const std::string &line);
+	struct Query
+	{
+		const char *line;
+		size_t len;
+		const char *date;
+		size_t dateLen;
+		const char *time;
+		const char *lastDate;
+		size_t lastDateLen;
+		const char *value;
+		size_t valueLen;
+		int day;
+		int seconds;
+		int lastDay;
+		double amount;
+		double rate;
+		double low;
+		double high;
+	};
 
-	bool validateDate(const std::string &date) const;
+	struct Row
+	{
+		const char *line;
+		size_t len;
+		const char *comma;
+		const char *date;
+		size_t dateLen;
+		const char *time;
+	};
+
+	struct DatabaseSource
+	{
+		std::string file;
+		size_t offset;
+		uint64_t tail;
+		off_t size;
+		ino_t inode;
+		time_t mtimeSec;
+		long mtimeNsec;
+	};
+
+	enum ReloadStatus
+	{
+		RELOAD_NONE,
+		RELOAD_APPENDED,
+		RELOAD_REWRITTEN
+	};
+
+	RateTable database;
+	DatabaseSource source;
+	size_t workers;
+	bool quiet;
+
+	void parseDatabase(const std::string &filename);
+	void recordSource(const std::string &filename, size_t offset);
+	bool watchSource();
+	ReloadStatus reloadDatabase(RateTable &rows);
+	static void parseRows(const char *begin, const char *end, bool header,
+		RateTable &table, OutputBuffer &errors);
+	static void splitRow(const char *line, size_t len, Row &row);
+	static Profile::Counter addRow(const Row &row, bool dateOk, int day,
+		RateTable &table, OutputBuffer &errors);
+	void processSequential(const char *begin, const char *end) const;
+	void processParallel(const char *begin, const char *end) const;
+	void processChunk(const char *begin, const char *end,
+		OutputBuffer &out) const;
+	static bool splitQuery(const char *line, size_t len, bool bareDate,
+		Query &q);
+	static QueryStatus checkQuery(Query &q, bool dateOk);
+	static QueryStatus lookupQuery(Query &q, const RateTable &table,
+		RateTable::Cursor &cursor);
+	static QueryStatus finishQuery(Query &q, bool dateOk,
+		const RateTable &table, RateTable::Cursor &cursor);
+	static QueryStatus evaluateQuery(const char *line, size_t len,
+		const RateTable &table, RateTable::Cursor &cursor, bool bareDate,
+		Query &q);
+	static void formatQuery(const Query &q, QueryStatus status,
+		OutputBuffer &out);
+	static void parseInputLine(const char *line, size_t len,
+		const RateTable &table, OutputBuffer &out,
+		RateTable::Cursor &cursor);
+
+	bool answerFrames(std::string &in, std::string &out) const;
+
+	static void *runWorker(void *arg);
+	static void *runReloader(void *arg);
+
+	static bool parseDate(const char *str, size_t len, int &day);
+	static bool parseTime(const char *str, int &seconds);
+	static void parseDates(const char *const *dates, const size_t *lengths,
+		size_t count, const char *end, int *days, unsigned char *valid);
+	static size_t parseDouble(const char *str, size_t len, double &value);
 
 	std::string trim(const std::string &str);
+	static void trim(const char *&begin, const char *&end);
 };
 #endif
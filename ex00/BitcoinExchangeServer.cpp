@@ -0,0 +1,294 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   BitcoinExchangeServer.cpp                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:22:23 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 03:08:10 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "BitcoinExchange.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <stdint.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Wire format, all integers little-endian:
+//   request  = u32 length | length bytes of '\n'-separated lines, each
+//              either `date | value` or a bare `date` (or `start..end`
+//              in place of the date)
+//   response = u32 count  | count records of 16 bytes:
+//              u8 status | 7 bytes zero | f64 value
+// status: 0 ok, 1 bad input, 2 negative value, 3 value above 1000, 4 no
+// earlier rate (the QueryStatus order). value is value * rate, the rate
+// itself for a bare date, or 0 on error; ranges use their average rate.
+// Frames are answered in order.
+static const size_t g_maxFrame = 16 << 20;
+// Per-client buffer caps. Input holds at most one whole frame; once this
+// much output is waiting, the client's frames are left unanswered and its
+// socket unread until the answers drain. A frame answered just below the
+// cap can overshoot it by that frame's records.
+static const size_t g_maxInput = 4 + g_maxFrame;
+static const size_t g_maxPending = 4 << 20;
+static const size_t g_recordSize = 16;
+static const int g_maxEvents = 256;
+
+static volatile sig_atomic_t g_stopServer = 0;
+
+static void stopServer(int signum) {
+  (void)signum;
+  g_stopServer = 1;
+}
+
+struct Client {
+  std::string in;
+  std::string out;
+  size_t sent;
+  uint32_t events;
+  bool closing;
+};
+
+static void putU32(std::string &out, uint32_t value) {
+  char bytes[4];
+
+  for (int i = 0; i < 4; ++i)
+    bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  out.append(bytes, 4);
+}
+
+static void putRecord(std::string &out, int status, double value) {
+  char bytes[g_recordSize];
+  uint64_t bits;
+
+  std::memset(bytes, 0, sizeof(bytes));
+  bytes[0] = static_cast<char>(status);
+  std::memcpy(&bits, &value, sizeof(bits));
+  for (int i = 0; i < 8; ++i)
+    bytes[8 + i] = static_cast<char>((bits >> (8 * i)) & 0xff);
+  out.append(bytes, sizeof(bytes));
+}
+
+static uint32_t getU32(const char *bytes) {
+  uint32_t value;
+
+  value = 0;
+  for (int i = 3; i >= 0; --i)
+    value = (value << 8) | static_cast<unsigned char>(bytes[i]);
+  return (value);
+}
+
+// Answers complete frames in `in` until `out` holds g_maxPending bytes;
+// false on an oversized frame
+bool BitcoinExchange::answerFrames(std::string &in, std::string &out) const {
+  size_t consumed;
+  size_t length;
+  size_t countAt;
+  uint32_t count;
+  const char *line;
+  const char *end;
+  const char *eol;
+  RateTable::Cursor cursor;
+  QueryStatus status;
+  Query q;
+
+  consumed = 0;
+  while (out.size() < g_maxPending && in.size() - consumed >= 4) {
+    length = getU32(in.data() + consumed);
+    if (length > g_maxFrame)
+      return (false);
+    if (in.size() - consumed - 4 < length)
+      break;
+    line = in.data() + consumed + 4;
+    end = line + length;
+    countAt = out.size();
+    putU32(out, 0);
+    count = 0;
+    cursor = RateTable::Cursor();
+    while (line < end) {
+      eol = static_cast<const char *>(std::memchr(line, '\n', end - line));
+      if (!eol)
+        eol = end;
+      if (eol != line) {
+        status = evaluateQuery(line, eol - line, this->database, cursor, true,
+                               q);
+        putRecord(out, status, status == QUERY_OK ? q.amount * q.rate : 0.0);
+        Profile::count(static_cast<Profile::Counter>(status), 1);
+        ++count;
+      }
+      line = eol + 1;
+    }
+    for (int i = 0; i < 4; ++i)
+      out[countAt + i] = static_cast<char>((count >> (8 * i)) & 0xff);
+    consumed += 4 + length;
+  }
+  in.erase(0, consumed);
+  return (true);
+}
+
+static bool hasFrame(const std::string &in) {
+  return (in.size() >= 4 && in.size() - 4 >= getU32(in.data()));
+}
+
+static bool flushClient(int fd, Client &c) {
+  ssize_t n;
+
+  while (c.sent < c.out.size()) {
+    n = send(fd, c.out.data() + c.sent, c.out.size() - c.sent, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+      return (true);
+    if (n <= 0)
+      return (false);
+    c.sent += n;
+  }
+  c.out.clear();
+  c.sent = 0;
+  return (true);
+}
+
+static void watch(int epfd, int op, int fd, uint32_t events) {
+  struct epoll_event ev;
+
+  std::memset(&ev, 0, sizeof(ev));
+  ev.events = events;
+  ev.data.fd = fd;
+  epoll_ctl(epfd, op, fd, &ev);
+}
+
+// The listener is left unwatched while accept4 is out of descriptors:
+// level-triggered, its pending connection would wake every epoll_wait
+static void setAccepting(int epfd, int listener, bool &accepting, bool on) {
+  if (accepting != on)
+    watch(epfd, EPOLL_CTL_MOD, listener, on ? EPOLLIN : 0u);
+  accepting = on;
+}
+
+// Single-threaded epoll loop over a Unix stream socket at path. Runs until
+// SIGINT or SIGTERM, then removes the socket file.
+void BitcoinExchange::serve(const std::string &path) {
+  struct sockaddr_un addr;
+  struct epoll_event events[g_maxEvents];
+  std::map<int, Client> clients;
+  std::map<int, Client>::iterator it;
+  char buffer[1 << 16];
+  int listener;
+  int epfd;
+  int ready;
+  int fd;
+  ssize_t n;
+  uint32_t wanted;
+  bool alive;
+  bool accepting;
+
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(addr.sun_path))
+    throw std::runtime_error("Error: socket path too long");
+  std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+  listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (listener < 0)
+    throw std::runtime_error("Error: could not create the socket");
+  unlink(path.c_str());
+  if (bind(listener, reinterpret_cast<struct sockaddr *>(&addr),
+           sizeof(addr)) != 0 ||
+      listen(listener, SOMAXCONN) != 0) {
+    close(listener);
+    throw std::runtime_error("Error: could not listen on " + path);
+  }
+  epfd = epoll_create1(EPOLL_CLOEXEC);
+  if (epfd < 0) {
+    close(listener);
+    unlink(path.c_str());
+    throw std::runtime_error("Error: could not create the event loop");
+  }
+  watch(epfd, EPOLL_CTL_ADD, listener, EPOLLIN);
+  accepting = true;
+  g_stopServer = 0;
+  signal(SIGINT, stopServer);
+  signal(SIGTERM, stopServer);
+  signal(SIGPIPE, SIG_IGN);
+  while (!g_stopServer) {
+    ready = epoll_wait(epfd, events, g_maxEvents, 500);
+    // Descriptors may also have been freed outside this loop
+    if (ready == 0)
+      setAccepting(epfd, listener, accepting, true);
+    for (int i = 0; i < ready; ++i) {
+      fd = events[i].data.fd;
+      if (fd == listener) {
+        while ((fd = accept4(listener, NULL, NULL,
+                             SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+          Client &c = clients[fd];
+          c.sent = 0;
+          c.events = EPOLLIN;
+          c.closing = false;
+          watch(epfd, EPOLL_CTL_ADD, fd, c.events);
+        }
+        if (errno == EMFILE || errno == ENFILE)
+          setAccepting(epfd, listener, accepting, false);
+        continue;
+      }
+      it = clients.find(fd);
+      if (it == clients.end())
+        continue;
+      Client &c = it->second;
+      alive = !(events[i].events & EPOLLERR);
+      if (alive && !c.closing && c.in.size() < g_maxInput &&
+          (events[i].events & (EPOLLIN | EPOLLHUP))) {
+        n = 1;
+        while (c.in.size() < g_maxInput &&
+               (n = recv(fd, buffer,
+                         std::min(sizeof(buffer), g_maxInput - c.in.size()),
+                         0)) > 0)
+          c.in.append(buffer, n);
+        if (n == 0)
+          c.closing = true;
+        else if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK &&
+                 errno != EINTR)
+          alive = false;
+      }
+      // Frames held back by the output cap are answered as it drains
+      do {
+        if (alive && !answerFrames(c.in, c.out))
+          alive = false;
+        if (alive && !c.out.empty() && !flushClient(fd, c))
+          alive = false;
+      } while (alive && c.out.empty() && hasFrame(c.in));
+      // A peer that shut down its side still gets the answers it is owed
+      if (!alive || (c.closing && c.out.empty())) {
+        epoll_ctl(epfd, EPOLL_CTL_DEL, fd, NULL);
+        close(fd);
+        clients.erase(it);
+        setAccepting(epfd, listener, accepting, true);
+        continue;
+      }
+      wanted = 0;
+      if (!c.closing && c.in.size() < g_maxInput &&
+          c.out.size() < g_maxPending)
+        wanted |= EPOLLIN;
+      if (!c.out.empty())
+        wanted |= EPOLLOUT;
+      if (wanted != c.events) {
+        c.events = wanted;
+        watch(epfd, EPOLL_CTL_MOD, fd, c.events);
+      }
+    }
+  }
+  for (it = clients.begin(); it != clients.end(); ++it)
+    close(it->first);
+  close(epfd);
+  close(listener);
+  unlink(path.c_str());
+  signal(SIGINT, SIG_DFL);
+  signal(SIGTERM, SIG_DFL);
+}
@@ -0,0 +1,272 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   BitcoinExchangeStream.cpp                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:21:07 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 02:58:53 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "BitcoinExchange.hpp"
+#include "Checksum.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// How often the reloader looks at the database file
+static const useconds_t g_reloadIntervalUs = 250000;
+static const useconds_t g_pollStepUs = 50000;
+// Bytes before the read offset hashed to tell an append from a rewrite
+static const size_t g_tailBytes = 4096;
+
+// The live table is swapped read-copy-update style: the reader never
+// waits, and the reloader reuses the previous table only once the reader
+// has left the batch that may still be using it. spare is that previous
+// table, one reload behind the live one.
+struct StreamState {
+  BitcoinExchange *btc;
+  RateTable *volatile live;
+  RateTable *spare;
+  volatile unsigned long readerSeq;
+  volatile int readerBusy;
+  volatile int stop;
+};
+
+static const RateTable *enterReader(StreamState &s) {
+  s.readerBusy = 1;
+  __sync_synchronize();
+  return (s.live);
+}
+
+static void leaveReader(StreamState &s) {
+  __sync_synchronize();
+  s.readerBusy = 0;
+  __sync_fetch_and_add(&s.readerSeq, 1);
+}
+
+// Returns the table fresh replaced, once the reader is done with it
+static RateTable *publish(StreamState &s, RateTable *fresh) {
+  RateTable *old;
+  unsigned long seq;
+
+  old = s.live;
+  s.live = fresh;
+  __sync_synchronize();
+  seq = s.readerSeq;
+  while (s.readerBusy && s.readerSeq == seq)
+    usleep(100);
+  return (old);
+}
+
+static uint64_t tailChecksum(const char *data, size_t offset) {
+  size_t len;
+
+  len = std::min(offset, g_tailBytes);
+  return (Checksum::fnv1a(data + offset - len, len));
+}
+
+// Called before the reloader starts: finds the read offset if the database
+// came from a snapshot and hashes the page before it. A file that changed
+// since it was read is marked for a full reload.
+bool BitcoinExchange::watchSource() {
+  struct stat st;
+  MappedFile file;
+  const char *eol;
+
+  if (this->source.file.empty())
+    return (false);
+  if (!file.open(this->source.file) ||
+      stat(this->source.file.c_str(), &st) != 0 ||
+      st.st_ino != this->source.inode || st.st_size != this->source.size ||
+      st.st_mtim.tv_sec != this->source.mtimeSec ||
+      st.st_mtim.tv_nsec != this->source.mtimeNsec) {
+    this->source.inode = 0;
+    return (true);
+  }
+  if (this->source.offset == std::string::npos) {
+    eol = static_cast<const char *>(memrchr(file.data(), '\n', file.size()));
+    this->source.offset = eol ? eol + 1 - file.data() : 0;
+  }
+  this->source.tail = tailChecksum(file.data(), this->source.offset);
+  return (true);
+}
+
+// Parses into rows, unfinalized, whatever was appended to the database
+// file since it was last read, or the whole file if it was replaced or
+// rewritten. A file that grew counts as rewritten unless the page before
+// the old end still has the same checksum.
+BitcoinExchange::ReloadStatus BitcoinExchange::reloadDatabase(
+    RateTable &rows) {
+  struct stat st;
+  MappedFile file;
+  OutputBuffer errors;
+  const char *eol;
+  bool rewritten;
+
+  if (this->quiet)
+    errors.mute(STDERR_FILENO);
+  if (stat(this->source.file.c_str(), &st) != 0)
+    return (RELOAD_NONE);
+  if (st.st_ino == this->source.inode && st.st_size == this->source.size &&
+      st.st_mtim.tv_sec == this->source.mtimeSec &&
+      st.st_mtim.tv_nsec == this->source.mtimeNsec)
+    return (RELOAD_NONE);
+  rewritten =
+      st.st_ino != this->source.inode || st.st_size <= this->source.size;
+  if (!file.open(this->source.file) || file.size() == 0)
+    return (RELOAD_NONE);
+  if (!rewritten && (file.size() < this->source.offset ||
+                     tailChecksum(file.data(), this->source.offset) !=
+                         this->source.tail))
+    rewritten = true;
+  if (rewritten)
+    this->source.offset = 0;
+  eol = static_cast<const char *>(memrchr(file.data(), '\n', file.size()));
+  // Only complete lines: a writer may be halfway through the last one
+  if (!eol || static_cast<size_t>(eol + 1 - file.data()) <= this->source.offset)
+    return (RELOAD_NONE);
+  parseRows(file.data() + this->source.offset, eol + 1,
+            this->source.offset == 0, rows, errors);
+  errors.flush();
+  this->source.offset = eol + 1 - file.data();
+  this->source.tail = tailChecksum(file.data(), this->source.offset);
+  this->source.size = st.st_size;
+  this->source.inode = st.st_ino;
+  this->source.mtimeSec = st.st_mtim.tv_sec;
+  this->source.mtimeNsec = st.st_mtim.tv_nsec;
+  return (rewritten ? RELOAD_REWRITTEN : RELOAD_APPENDED);
+}
+
+// Appended rows go into the spare table along with those the previous
+// reload gave the live one, so only the new rows are indexed
+void *BitcoinExchange::runReloader(void *arg) {
+  StreamState *s;
+  RateTable rows;
+  RateTable missed;
+  ReloadStatus status;
+  useconds_t waited;
+
+  s = static_cast<StreamState *>(arg);
+  while (!s->stop) {
+    for (waited = 0; waited < g_reloadIntervalUs && !s->stop;
+         waited += g_pollStepUs)
+      usleep(g_pollStepUs);
+    if (s->stop)
+      break;
+    rows.clear();
+    status = s->btc->reloadDatabase(rows);
+    if (status == RELOAD_NONE)
+      continue;
+    if (status == RELOAD_REWRITTEN)
+      s->spare->clear();
+    else
+      s->spare->append(missed);
+    s->spare->append(rows);
+    s->spare->finalize();
+    s->spare = publish(*s, s->spare);
+    // Only this thread replaces s->live, so reading it here is safe
+    if (status == RELOAD_REWRITTEN) {
+      *s->spare = *s->live;
+      missed.clear();
+    } else
+      missed = rows;
+  }
+  return (NULL);
+}
+
+static bool isHeader(const char *line, size_t len) {
+  while (len > 0 && (*line == ' ' || *line == '\t')) {
+    ++line;
+    --len;
+  }
+  while (len > 0 && (line[len - 1] == ' ' || line[len - 1] == '\t'))
+    --len;
+  return (len == 12 && std::memcmp(line, "date | value", 12) == 0);
+}
+
+// Answers `date | value` queries as they arrive on stdin (empty filename)
+// or on a named pipe, which is reopened whenever its writer goes away.
+// A leading "date | value" header line is accepted and ignored.
+void BitcoinExchange::streamInput(const std::string &filename) {
+  StreamState s;
+  pthread_t reloader;
+  bool reloading;
+  std::string pending;
+  OutputBuffer out;
+  const RateTable *table;
+  const RateTable *previous;
+  struct stat st;
+  char buffer[1 << 16];
+  RateTable::Cursor cursor;
+  size_t begin;
+  size_t eol;
+  ssize_t n;
+  int fd;
+  bool fifo;
+  bool eof;
+
+  fd = filename.empty() ? STDIN_FILENO : open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    std::cerr << "Error: could not open the input file" << std::endl;
+    return;
+  }
+  fifo = !filename.empty() && fstat(fd, &st) == 0 && S_ISFIFO(st.st_mode);
+  if (this->quiet)
+    out.mute(STDERR_FILENO);
+  s.btc = this;
+  s.live = new RateTable(this->database);
+  s.spare = new RateTable(this->database);
+  s.readerSeq = 0;
+  s.readerBusy = 0;
+  s.stop = 0;
+  reloading = watchSource() &&
+              pthread_create(&reloader, NULL, runReloader, &s) == 0;
+  previous = NULL;
+  while (true) {
+    n = read(fd, buffer, sizeof(buffer));
+    if (n < 0 && errno == EINTR)
+      continue;
+    eof = n <= 0;
+    if (!eof)
+      pending.append(buffer, n);
+    else if (!pending.empty() && pending[pending.size() - 1] != '\n')
+      pending += '\n';
+    table = enterReader(s);
+    if (table != previous)
+      cursor = RateTable::Cursor();
+    previous = table;
+    begin = 0;
+    while ((eol = pending.find('\n', begin)) != std::string::npos) {
+      if (eol != begin && !isHeader(pending.data() + begin, eol - begin))
+        parseInputLine(pending.data() + begin, eol - begin, *table, out,
+                       cursor);
+      begin = eol + 1;
+    }
+    leaveReader(s);
+    pending.erase(0, begin);
+    out.flush();
+    if (!eof)
+      continue;
+    if (!fifo)
+      break;
+    close(fd);
+    fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      break;
+  }
+  if (fd >= 0 && fd != STDIN_FILENO)
+    close(fd);
+  s.stop = 1;
+  if (reloading)
+    pthread_join(reloader, NULL);
+  delete s.live;
+  delete s.spare;
+}
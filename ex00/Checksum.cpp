@@ -0,0 +1,28 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Checksum.cpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:54:28 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 02:58:53 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+#include "Checksum.hpp"
+#include <cstring>
+
+uint64_t Checksum::fnv1a(const char *data, size_t len) {
+  uint64_t hash;
+  uint64_t word;
+  size_t i;
+
+  hash = 14695981039346656037ULL;
+  for (i = 0; i + 8 <= len; i += 8) {
+    std::memcpy(&word, data + i, 8);
+    hash = (hash ^ word) * 1099511628211ULL;
+  }
+  for (; i < len; ++i)
+    hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+  return (hash);
+}
@@ -0,0 +1,31 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Checksum.hpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:54:28 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 02:58:53 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+#ifndef CHECKSUM__HPP
+# define CHECKSUM__HPP
+# include <cstddef>
+# include <stdint.h>
+
+// 64-bit FNV-1a applied per 8-byte word instead of per byte, with the
+// last len % 8 bytes taken one at a time. Used to validate snapshots and
+// to notice a database file rewritten in place.
+class Checksum
+{
+  public:
+	static uint64_t fnv1a(const char *data, size_t len);
+
+  private:
+	Checksum();
+	Checksum(const Checksum &other);
+	Checksum &operator=(const Checksum &other);
+	~Checksum();
+};
+#endif
@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MappedFile.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:13:01 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:13:01 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MappedFile.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile() : begin(NULL), length(0), mapped(false) {}
+
+MappedFile::MappedFile(const MappedFile &other)
+    : begin(NULL), length(0), mapped(false) {
+  (void)other;
+}
+
+MappedFile &MappedFile::operator=(const MappedFile &other) {
+  (void)other;
+  return (*this);
+}
+
+MappedFile::~MappedFile() { close(); }
+
+bool MappedFile::open(const std::string &filename) {
+  struct stat st;
+  int fd;
+  void *addr;
+
+  close();
+  fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return (false);
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+    if (st.st_size == 0) {
+      ::close(fd);
+      return (true);
+    }
+    addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED) {
+      madvise(addr, st.st_size, MADV_SEQUENTIAL);
+      begin = static_cast<const char *>(addr);
+      length = st.st_size;
+      mapped = true;
+      ::close(fd);
+      return (true);
+    }
+  }
+  // Directories read as empty, like an std::ifstream on them would
+  if (!readAll(fd)) {
+    close();
+    length = 0;
+  }
+  ::close(fd);
+  return (true);
+}
+
+bool MappedFile::readAll(int fd) {
+  size_t capacity;
+  ssize_t n;
+  char *buffer;
+  char *grown;
+
+  capacity = 1 << 16;
+  buffer = static_cast<char *>(std::malloc(capacity));
+  if (!buffer)
+    return (false);
+  begin = buffer;
+  while (true) {
+    if (length == capacity) {
+      grown = static_cast<char *>(std::realloc(buffer, capacity * 2));
+      if (!grown)
+        return (false);
+      buffer = grown;
+      begin = buffer;
+      capacity *= 2;
+    }
+    n = read(fd, buffer + length, capacity - length);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return (n == 0);
+    length += n;
+  }
+}
+
+void MappedFile::close() {
+  if (begin) {
+    if (mapped)
+      munmap(const_cast<char *>(begin), length);
+    else
+      std::free(const_cast<char *>(begin));
+  }
+  begin = NULL;
+  length = 0;
+  mapped = false;
+}
+
+const char *MappedFile::data() const { return (begin); }
+
+size_t MappedFile::size() const { return (length); }
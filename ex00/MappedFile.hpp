@@ -0,0 +1,42 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MappedFile.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:13:00 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:13:00 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MAPPED_FILE__HPP
+# define MAPPED_FILE__HPP
+# include <cstddef>
+# include <string>
+
+// Read-only view of a whole file. Regular files are mmapped; anything that
+// cannot be mapped (pipes, /dev/stdin) is read into a private buffer.
+class MappedFile
+{
+  public:
+	MappedFile();
+	~MappedFile();
+
+	bool open(const std::string &filename);
+	void close();
+
+	const char *data() const;
+	size_t size() const;
+
+  private:
+	const char *begin;
+	size_t length;
+	bool mapped;
+
+	MappedFile(const MappedFile &other);
+	MappedFile &operator=(const MappedFile &other);
+
+	bool readAll(int fd);
+};
+#endif
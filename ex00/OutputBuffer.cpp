@@ -0,0 +1,239 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   OutputBuffer.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:16:34 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:35:43 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "OutputBuffer.hpp"
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+OutputBuffer::OutputBuffer() : stream(STDOUT_FILENO), mutedStream(-1) {}
+
+OutputBuffer::OutputBuffer(const OutputBuffer &other)
+    : text(other.text), runs(other.runs), stream(other.stream),
+      mutedStream(other.mutedStream) {}
+
+OutputBuffer &OutputBuffer::operator=(const OutputBuffer &other) {
+  if (this != &other) {
+    text = other.text;
+    runs = other.runs;
+    stream = other.stream;
+    mutedStream = other.mutedStream;
+  }
+  return (*this);
+}
+
+OutputBuffer::~OutputBuffer() {}
+
+void OutputBuffer::setStream(int fd) { stream = fd; }
+
+// Text for fd is dropped from now on; callers can check muted() to skip
+// formatting it at all
+void OutputBuffer::mute(int fd) { mutedStream = fd; }
+
+bool OutputBuffer::muted(int fd) const { return (fd == mutedStream); }
+
+void OutputBuffer::append(const char *str, size_t len) {
+  Run run;
+
+  if (len == 0 || stream == mutedStream)
+    return;
+  if (runs.empty() || runs.back().fd != stream) {
+    run.fd = stream;
+    run.length = 0;
+    runs.push_back(run);
+  }
+  runs.back().length += len;
+  text.append(str, len);
+}
+
+void OutputBuffer::append(const char *str) { append(str, std::strlen(str)); }
+
+// Same text as `std::ostream << double` with the default flags, i.e.
+// printf's %.6g. Six significant digits are taken from one exact-power
+// scaling; values too close to a rounding tie, or too far out of range for
+// the powers of ten to be exact, are left to snprintf.
+void OutputBuffer::appendDouble(double value) {
+  static const double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                 1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                 1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                 1e18, 1e19, 1e20, 1e21, 1e22};
+  char buffer[32];
+  char digits[6];
+  char *p;
+  double magnitude;
+  double scaled;
+  double fraction;
+  long mantissa;
+  int exp10;
+  int last;
+
+  magnitude = value < 0 ? -value : value;
+  if (value == 0 || magnitude != magnitude || magnitude > 1e27 ||
+      magnitude < 1e-17) {
+    append(buffer, std::snprintf(buffer, sizeof(buffer), "%.6g", value));
+    return;
+  }
+  exp10 = static_cast<int>(std::floor(std::log10(magnitude)));
+  while (true) {
+    if (exp10 < -17 || exp10 > 27) {
+      append(buffer, std::snprintf(buffer, sizeof(buffer), "%.6g", value));
+      return;
+    }
+    scaled = exp10 <= 5 ? magnitude * pow10[5 - exp10]
+                        : magnitude / pow10[exp10 - 5];
+    if (scaled < 1e5)
+      --exp10;
+    else if (scaled >= 1e6)
+      ++exp10;
+    else
+      break;
+  }
+  mantissa = static_cast<long>(scaled);
+  fraction = scaled - mantissa;
+  if (fraction > 0.5 - 1e-6 && fraction < 0.5 + 1e-6) {
+    append(buffer, std::snprintf(buffer, sizeof(buffer), "%.6g", value));
+    return;
+  }
+  if (fraction > 0.5 && ++mantissa == 1000000) {
+    mantissa = 100000;
+    ++exp10;
+  }
+  for (int i = 5; i >= 0; --i) {
+    digits[i] = '0' + mantissa % 10;
+    mantissa /= 10;
+  }
+  last = 5;
+  while (last > 0 && digits[last] == '0')
+    --last;
+  p = buffer;
+  if (value < 0)
+    *p++ = '-';
+  if (exp10 >= 6 || exp10 < -4) {
+    *p++ = digits[0];
+    if (last > 0) {
+      *p++ = '.';
+      for (int i = 1; i <= last; ++i)
+        *p++ = digits[i];
+    }
+    *p++ = 'e';
+    *p++ = exp10 < 0 ? '-' : '+';
+    if (exp10 < 0)
+      exp10 = -exp10;
+    *p++ = '0' + exp10 / 10;
+    *p++ = '0' + exp10 % 10;
+  } else if (exp10 >= 0) {
+    for (int i = 0; i <= exp10; ++i)
+      *p++ = digits[i];
+    if (last > exp10) {
+      *p++ = '.';
+      for (int i = exp10 + 1; i <= last; ++i)
+        *p++ = digits[i];
+    }
+  } else {
+    *p++ = '0';
+    *p++ = '.';
+    for (int i = -1; i > exp10; --i)
+      *p++ = '0';
+    for (int i = 0; i <= last; ++i)
+      *p++ = digits[i];
+  }
+  append(buffer, p - buffer);
+}
+
+void OutputBuffer::endLine() { append("\n", 1); }
+
+// True when stdout and stderr end up in the same file, pipe or terminal;
+// the text is then written as one stream so the interleaving survives
+static pthread_once_t g_targetOnce = PTHREAD_ONCE_INIT;
+static bool g_sharedTarget = false;
+
+static void detectTarget() {
+  struct stat out;
+  struct stat err;
+
+  g_sharedTarget = fstat(STDOUT_FILENO, &out) == 0 &&
+                   fstat(STDERR_FILENO, &err) == 0 &&
+                   out.st_dev == err.st_dev && out.st_ino == err.st_ino;
+}
+
+static bool sharedTarget() {
+  pthread_once(&g_targetOnce, detectTarget);
+  return (g_sharedTarget);
+}
+
+static void writeAll(int fd, struct iovec *iov, int count) {
+  ssize_t n;
+
+  while (count > 0) {
+    n = writev(fd, iov, count);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return;
+    while (count > 0 && static_cast<size_t>(n) >= iov->iov_len) {
+      n -= iov->iov_len;
+      ++iov;
+      --count;
+    }
+    if (count > 0) {
+      iov->iov_base = static_cast<char *>(iov->iov_base) + n;
+      iov->iov_len -= n;
+    }
+  }
+}
+
+// Runs of one stream are gathered into as few writev calls as possible
+void OutputBuffer::writeRuns(int fd) const {
+  struct iovec iov[IOV_MAX];
+  size_t offset;
+  int count;
+
+  offset = 0;
+  count = 0;
+  for (size_t i = 0; i < runs.size(); ++i) {
+    if (fd < 0 || runs[i].fd == fd) {
+      iov[count].iov_base = const_cast<char *>(text.data() + offset);
+      iov[count].iov_len = runs[i].length;
+      if (++count == IOV_MAX) {
+        writeAll(fd < 0 ? STDOUT_FILENO : fd, iov, count);
+        count = 0;
+      }
+    }
+    offset += runs[i].length;
+  }
+  writeAll(fd < 0 ? STDOUT_FILENO : fd, iov, count);
+}
+
+void OutputBuffer::flush() {
+  if (runs.empty())
+    return;
+  if (sharedTarget())
+    writeRuns(-1);
+  else {
+    writeRuns(STDOUT_FILENO);
+    writeRuns(STDERR_FILENO);
+  }
+  clear();
+}
+
+void OutputBuffer::clear() {
+  text.clear();
+  runs.clear();
+}
+
+bool OutputBuffer::empty() const { return (runs.empty()); }
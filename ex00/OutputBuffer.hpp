@@ -0,0 +1,56 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   OutputBuffer.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:16:34 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:35:43 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef OUTPUT_BUFFER__HPP
+# define OUTPUT_BUFFER__HPP
+# include <cstddef>
+# include <string>
+# include <vector>
+
+// Text destined for stdout and stderr, kept in the order it was produced
+// so that a chunk processed off the main thread can be written out later
+// exactly as if it had been printed line by line.
+class OutputBuffer
+{
+  public:
+	OutputBuffer();
+	OutputBuffer(const OutputBuffer &other);
+	OutputBuffer &operator=(const OutputBuffer &other);
+	~OutputBuffer();
+
+	void setStream(int fd);
+	void mute(int fd);
+	bool muted(int fd) const;
+	void append(const char *str, size_t len);
+	void append(const char *str);
+	void appendDouble(double value);
+	void endLine();
+
+	void flush();
+	void clear();
+	bool empty() const;
+
+  private:
+	struct Run
+	{
+		int fd;
+		size_t length;
+	};
+
+	std::string text;
+	std::vector<Run> runs;
+	int stream;
+	int mutedStream;
+
+	void writeRuns(int fd) const;
+};
+#endif
@@ -0,0 +1,102 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Profile.cpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:27:32 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:35:43 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Profile.hpp"
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+volatile uint64_t Profile::totals[Profile::PHASES] = {0, 0, 0, 0};
+volatile uint64_t Profile::counts[Profile::COUNTERS] = {0, 0, 0, 0, 0,
+                                                        0, 0, 0, 0};
+uint64_t Profile::started = Profile::now();
+
+uint64_t Profile::now() {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (static_cast<uint64_t>(ts.tv_sec) * 1000000000u + ts.tv_nsec);
+}
+
+void Profile::add(Phase phase, uint64_t nanoseconds) {
+  __sync_fetch_and_add(&totals[phase], nanoseconds);
+}
+
+uint64_t Profile::total(Phase phase) {
+  return (__sync_fetch_and_add(&totals[phase], 0));
+}
+
+const char *Profile::name(Phase phase) {
+  static const char *const names[PHASES] = {"load", "parse", "lookup",
+                                            "output"};
+
+  return (names[phase]);
+}
+
+void Profile::count(Counter counter, uint64_t amount) {
+  if (amount)
+    __sync_fetch_and_add(&counts[counter], amount);
+}
+
+uint64_t Profile::total(Counter counter) {
+  return (__sync_fetch_and_add(&counts[counter], 0));
+}
+
+const char *Profile::name(Counter counter) {
+  static const char *const names[COUNTERS] = {
+      "ok", "bad_input", "negative", "too_large", "no_rate",
+      "ok", "bad_line",  "bad_date", "bad_rate"};
+
+  return (names[counter]);
+}
+
+// Nanoseconds since the process started or the last reset()
+uint64_t Profile::elapsed() { return (now() - started); }
+
+static void appendGroup(std::ostringstream &json, const char *group,
+                        Profile::Counter first, Profile::Counter last) {
+  uint64_t sum;
+
+  sum = 0;
+  for (int i = first; i <= last; ++i)
+    sum += Profile::total(static_cast<Profile::Counter>(i));
+  json << ",\n  \"" << group << "\": {\"total\": " << sum;
+  for (int i = first; i <= last; ++i)
+    json << ", \"" << Profile::name(static_cast<Profile::Counter>(i))
+         << "\": " << Profile::total(static_cast<Profile::Counter>(i));
+  json << "}";
+}
+
+// The counters and timers as a JSON object, times in milliseconds
+std::string Profile::summary() {
+  std::ostringstream json;
+
+  json << std::fixed << std::setprecision(3);
+  json << "{\n  \"wall_ms\": " << elapsed() / 1e6;
+  json << ",\n  \"phases_ms\": {";
+  for (int i = 0; i < PHASES; ++i)
+    json << (i ? ", \"" : "\"") << name(static_cast<Phase>(i))
+         << "\": " << total(static_cast<Phase>(i)) / 1e6;
+  json << "}";
+  appendGroup(json, "lines", LINES_OK, LINES_NO_RATE);
+  appendGroup(json, "rows", ROWS_OK, ROWS_BAD_RATE);
+  json << "\n}\n";
+  return (json.str());
+}
+
+void Profile::reset() {
+  for (int i = 0; i < PHASES; ++i)
+    __sync_lock_test_and_set(&totals[i], 0);
+  for (int i = 0; i < COUNTERS; ++i)
+    __sync_lock_test_and_set(&counts[i], 0);
+  started = now();
+}
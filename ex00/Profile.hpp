@@ -0,0 +1,70 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Profile.hpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:27:32 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:35:43 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PROFILE__HPP
+# define PROFILE__HPP
+# include <stdint.h>
+# include <string>
+
+// Process-wide time spent in each phase of the pipeline, in nanoseconds
+// of CLOCK_MONOTONIC, and counts of input lines and database rows by
+// outcome. Workers add to the same totals, so with several threads a
+// phase can add up to more than the wall-clock time.
+class Profile
+{
+  public:
+	enum Phase
+	{
+		LOAD,
+		PARSE,
+		LOOKUP,
+		OUTPUT,
+		PHASES
+	};
+
+	// The LINES_* entries follow BitcoinExchange::QueryStatus
+	enum Counter
+	{
+		LINES_OK,
+		LINES_BAD_INPUT,
+		LINES_NEGATIVE,
+		LINES_TOO_LARGE,
+		LINES_NO_RATE,
+		ROWS_OK,
+		ROWS_BAD_LINE,
+		ROWS_BAD_DATE,
+		ROWS_BAD_RATE,
+		COUNTERS
+	};
+
+	static uint64_t now();
+	static void add(Phase phase, uint64_t nanoseconds);
+	static uint64_t total(Phase phase);
+	static const char *name(Phase phase);
+	static void count(Counter counter, uint64_t amount);
+	static uint64_t total(Counter counter);
+	static const char *name(Counter counter);
+	static uint64_t elapsed();
+	static std::string summary();
+	static void reset();
+
+  private:
+	static volatile uint64_t totals[PHASES];
+	static volatile uint64_t counts[COUNTERS];
+	static uint64_t started;
+
+	Profile();
+	Profile(const Profile &other);
+	Profile &operator=(const Profile &other);
+	~Profile();
+};
+#endif
@@ -0,0 +1,159 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RateSnapshot.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:15:38 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 03:06:24 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "RateSnapshot.hpp"
+#include "Checksum.hpp"
+#include "MappedFile.hpp"
+#include "Profile.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sstream>
+#include <stdint.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char g_magic[8] = {'B', 'T', 'C', 'S', 'N', 'A', 'P', '\0'};
+static const uint32_t g_version = 2;
+static const int g_rowCounters = Profile::ROWS_BAD_RATE - Profile::ROWS_OK + 1;
+
+struct SnapshotHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t headerSize;
+  uint64_t count;
+  uint64_t sourceSize;
+  int64_t sourceMtimeSec;
+  int64_t sourceMtimeNsec;
+  uint64_t rows[g_rowCounters];
+  uint64_t checksum;
+};
+
+static size_t ratesOffset(uint64_t count) {
+  return ((sizeof(SnapshotHeader) + count * sizeof(int32_t) + 7) & ~size_t(7));
+}
+
+static bool statSource(const std::string &csvFile, SnapshotHeader &header) {
+  struct stat st;
+
+  if (stat(csvFile.c_str(), &st) != 0)
+    return (false);
+  header.sourceSize = st.st_size;
+  header.sourceMtimeSec = st.st_mtim.tv_sec;
+  header.sourceMtimeNsec = st.st_mtim.tv_nsec;
+  return (true);
+}
+
+static bool writeAll(int fd, const char *data, size_t len) {
+  ssize_t n;
+
+  while (len > 0) {
+    n = write(fd, data, len);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return (false);
+    data += n;
+    len -= n;
+  }
+  return (true);
+}
+
+std::string RateSnapshot::pathFor(const std::string &csvFile) {
+  return (csvFile + ".snap");
+}
+
+bool RateSnapshot::load(RateTable &table, const std::string &csvFile) {
+  MappedFile file;
+  SnapshotHeader header;
+  SnapshotHeader source;
+  const char *payload;
+
+  if (!statSource(csvFile, source) || !file.open(pathFor(csvFile)))
+    return (false);
+  if (file.size() < sizeof(header))
+    return (false);
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (std::memcmp(header.magic, g_magic, sizeof(g_magic)) != 0 ||
+      header.version != g_version || header.headerSize != sizeof(header))
+    return (false);
+  if (header.sourceSize != source.sourceSize ||
+      header.sourceMtimeSec != source.sourceMtimeSec ||
+      header.sourceMtimeNsec != source.sourceMtimeNsec)
+    return (false);
+  if (header.count > file.size() ||
+      ratesOffset(header.count) + header.count * sizeof(double) != file.size())
+    return (false);
+  payload = file.data() + sizeof(header);
+  if (Checksum::fnv1a(payload, file.size() - sizeof(header)) !=
+      header.checksum)
+    return (false);
+  // The mapping is page aligned, so both arrays are naturally aligned
+  if (!table.assign(reinterpret_cast<const int *>(payload),
+                    reinterpret_cast<const double *>(
+                        file.data() + ratesOffset(header.count)),
+                    header.count))
+    return (false);
+  for (int i = 0; i < g_rowCounters; ++i)
+    Profile::count(static_cast<Profile::Counter>(Profile::ROWS_OK + i),
+                   header.rows[i]);
+  return (true);
+}
+
+bool RateSnapshot::save(const RateTable &table, const std::string &csvFile) {
+  SnapshotHeader header;
+  std::string path;
+  std::string tmpPath;
+  std::ostringstream tmpName;
+  std::vector<char> buffer;
+  const std::vector<int> &days = table.getDays();
+  const std::vector<double> &rates = table.getRates();
+  int fd;
+  bool ok;
+
+  std::memset(&header, 0, sizeof(header));
+  if (!statSource(csvFile, header))
+    return (false);
+  std::memcpy(header.magic, g_magic, sizeof(g_magic));
+  header.version = g_version;
+  header.headerSize = sizeof(header);
+  header.count = days.size();
+  // Profile only holds the counters of the parse that built table
+  for (int i = 0; i < g_rowCounters; ++i)
+    header.rows[i] =
+        Profile::total(static_cast<Profile::Counter>(Profile::ROWS_OK + i));
+  buffer.resize(ratesOffset(header.count) + header.count * sizeof(double));
+  if (!days.empty()) {
+    std::memcpy(&buffer[sizeof(header)], &days[0], days.size() * sizeof(int));
+    std::memcpy(&buffer[ratesOffset(header.count)], &rates[0],
+                rates.size() * sizeof(double));
+  }
+  header.checksum = Checksum::fnv1a(&buffer[0] + sizeof(header),
+                                    buffer.size() - sizeof(header));
+  std::memcpy(&buffer[0], &header, sizeof(header));
+  // Write beside the target and rename, so readers never see half a file
+  path = pathFor(csvFile);
+  tmpName << path << ".tmp." << getpid();
+  tmpPath = tmpName.str();
+  fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+    return (false);
+  ok = writeAll(fd, &buffer[0], buffer.size());
+  if (close(fd) != 0)
+    ok = false;
+  if (ok && std::rename(tmpPath.c_str(), path.c_str()) != 0)
+    ok = false;
+  if (!ok)
+    unlink(tmpPath.c_str());
+  return (ok);
+}
@@ -0,0 +1,37 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RateSnapshot.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:15:38 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 03:06:24 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RATE_SNAPSHOT__HPP
+# define RATE_SNAPSHOT__HPP
+# include "RateTable.hpp"
+# include <string>
+
+// Binary image of a finalized RateTable, stored beside the CSV it was
+// built from. The header records the size and mtime of that CSV so a
+// snapshot is ignored as soon as the CSV is touched, and the Profile row
+// counters of its parse, which load() adds back.
+//
+//   header (80 bytes) | int32 days[count] | pad to 8 | double rates[count]
+class RateSnapshot
+{
+  public:
+	static std::string pathFor(const std::string &csvFile);
+	static bool load(RateTable &table, const std::string &csvFile);
+	static bool save(const RateTable &table, const std::string &csvFile);
+
+  private:
+	RateSnapshot();
+	RateSnapshot(const RateSnapshot &other);
+	RateSnapshot &operator=(const RateSnapshot &other);
+	~RateSnapshot();
+};
+#endif
@@ -0,0 +1,462 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RateTable.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:14:52 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 03:05:53 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "RateTable.hpp"
+#include <algorithm>
+#include <utility>
+
+// The forward-filled table is only built while it costs at most this many
+// slots per stored rate (plus some slack for tiny databases)
+static const size_t g_maxDailySlotsPerRate = 8;
+static const size_t g_minDailySlots = 1 << 16;
+// Rows per block of the range indexes; extremes scan at most two blocks
+static const size_t g_rangeBlock = 64;
+static const int64_t g_secondsPerDay = 86400;
+
+RateTable::Cursor::Cursor() : day(0), tick(0) {}
+
+RateTable::RateTable() : sorted(true), indexed(0) {}
+
+RateTable::RateTable(const RateTable &other)
+    : days(other.days), rates(other.rates), daily(other.daily),
+      dailyRows(other.dailyRows), blockSums(other.blockSums),
+      blockErrors(other.blockErrors), sums(other.sums),
+      sumErrors(other.sumErrors), lows(other.lows), highs(other.highs),
+      ticks(other.ticks), sorted(other.sorted), indexed(other.indexed) {}
+
+RateTable &RateTable::operator=(const RateTable &other) {
+  if (this != &other) {
+    days = other.days;
+    rates = other.rates;
+    daily = other.daily;
+    dailyRows = other.dailyRows;
+    blockSums = other.blockSums;
+    blockErrors = other.blockErrors;
+    sums = other.sums;
+    sumErrors = other.sumErrors;
+    lows = other.lows;
+    highs = other.highs;
+    ticks = other.ticks;
+    sorted = other.sorted;
+    indexed = other.indexed;
+  }
+  return (*this);
+}
+
+RateTable::~RateTable() {}
+
+// A later row for the same day replaces the earlier one
+void RateTable::insert(int day, double rate) {
+  if (!days.empty() && sorted) {
+    if (day == days.back()) {
+      rates.back() = rate;
+      indexed = std::min(indexed, days.size() - 1);
+      return;
+    }
+    if (day < days.back())
+      sorted = false;
+  }
+  days.push_back(day);
+  rates.push_back(rate);
+}
+
+// Seconds since midnight; a later tick at the same second wins
+void RateTable::insertTick(int day, int seconds, double rate) {
+  ticks.insert(day * g_secondsPerDay + seconds, rate);
+}
+
+// Inserts the rows and ticks of a table that has not been finalized, in
+// the order they were added to it
+void RateTable::append(const RateTable &rows) {
+  for (size_t i = 0; i < rows.days.size(); ++i)
+    insert(rows.days[i], rows.rates[i]);
+  ticks.append(rows.ticks);
+}
+
+void RateTable::finalize() {
+  if (!sorted)
+    sortAndMerge();
+  buildIndexes(indexed);
+  indexed = days.size();
+  ticks.finalize();
+}
+
+void RateTable::clear() {
+  days.clear();
+  rates.clear();
+  daily.clear();
+  dailyRows.clear();
+  blockSums.clear();
+  blockErrors.clear();
+  sums.clear();
+  sumErrors.clear();
+  lows.clear();
+  highs.clear();
+  ticks.clear();
+  sorted = true;
+  indexed = 0;
+}
+
+// Bulk load of already finalized data; rejects days that are not strictly
+// increasing
+bool RateTable::assign(const int *sortedDays, const double *dayRates,
+                       size_t count) {
+  for (size_t i = 1; i < count; ++i) {
+    if (sortedDays[i - 1] >= sortedDays[i])
+      return (false);
+  }
+  days.assign(sortedDays, sortedDays + count);
+  rates.assign(dayRates, dayRates + count);
+  sorted = true;
+  buildIndexes(0);
+  indexed = count;
+  return (true);
+}
+
+static bool lessDay(const std::pair<int, double> &a,
+                    const std::pair<int, double> &b) {
+  return (a.first < b.first);
+}
+
+void RateTable::sortAndMerge() {
+  std::vector<std::pair<int, double> > rows(days.size());
+  size_t out;
+
+  for (size_t i = 0; i < days.size(); ++i)
+    rows[i] = std::make_pair(days[i], rates[i]);
+  // stable, so the last row of each day is the last of its run
+  std::stable_sort(rows.begin(), rows.end(), lessDay);
+  out = 0;
+  for (size_t i = 0; i < rows.size(); ++i) {
+    if (out > 0 && days[out - 1] == rows[i].first)
+      --out;
+    days[out] = rows[i].first;
+    rates[out] = rows[i].second;
+    ++out;
+  }
+  days.resize(out);
+  rates.resize(out);
+  sorted = true;
+  indexed = 0;
+}
+
+// Rows before from are those the indexes were last built with, unchanged
+void RateTable::buildIndexes(size_t from) {
+  buildDaily(from);
+  buildRanges(from);
+}
+
+void RateTable::buildDaily(size_t from) {
+  size_t span;
+  size_t slot;
+  size_t r;
+
+  if (days.empty()) {
+    daily.clear();
+    dailyRows.clear();
+    return;
+  }
+  span = static_cast<size_t>(days.back() - days.front()) + 1;
+  if (span > g_minDailySlots && span / g_maxDailySlotsPerRate > days.size()) {
+    daily.clear();
+    dailyRows.clear();
+    return;
+  }
+  // The slots before row from - 1's day only depend on earlier rows, but
+  // they must have been built
+  if (from > 0 &&
+      daily.size() <= static_cast<size_t>(days[from - 1] - days.front()))
+    from = 0;
+  r = from > 0 ? from - 1 : 0;
+  slot = static_cast<size_t>(days[r] - days.front());
+  daily.resize(span);
+  dailyRows.resize(span);
+  for (size_t i = slot; i < span; ++i) {
+    if (r + 1 < days.size() &&
+        static_cast<size_t>(days[r + 1] - days.front()) == i)
+      ++r;
+    daily[i] = rates[r];
+    dailyRows[i] = static_cast<uint32_t>(r);
+  }
+}
+
+// Adds value to sum and what the addition rounded off to error (two-sum)
+static void addExact(long double &sum, long double &error,
+                     long double value) {
+  long double next;
+  long double part;
+
+  next = sum + value;
+  part = next - sum;
+  error += (sum - (next - part)) + (value - part);
+  sum = next;
+}
+
+void RateTable::buildRanges(size_t from) {
+  size_t blocks;
+  size_t width;
+  size_t at;
+  size_t start;
+  long double base;
+  long double baseError;
+  long double local;
+  long double localError;
+  long double held;
+
+  // Row from - 1 now has a successor, so its block is summed again from
+  // its first row; earlier blocks keep their sums and extremes
+  start = from > 0 ? (from - 1) / g_rangeBlock * g_rangeBlock : 0;
+  base = start > 0 ? blockSums[start / g_rangeBlock] : 0;
+  baseError = start > 0 ? blockErrors[start / g_rangeBlock] : 0;
+  blocks = (days.size() + g_rangeBlock - 1) / g_rangeBlock;
+  blockSums.resize(blocks);
+  blockErrors.resize(blocks);
+  sums.resize(days.size());
+  sumErrors.resize(days.size());
+  lows.resize(blocks);
+  highs.resize(blocks);
+  local = 0;
+  localError = 0;
+  for (size_t i = start; i < days.size(); ++i) {
+    if (i % g_rangeBlock == 0) {
+      blockSums[i / g_rangeBlock] = base;
+      blockErrors[i / g_rangeBlock] = baseError;
+      local = 0;
+      localError = 0;
+      lows[i / g_rangeBlock] = rates[i];
+      highs[i / g_rangeBlock] = rates[i];
+    }
+    sums[i] = static_cast<double>(local);
+    sumErrors[i] = static_cast<double>((local - sums[i]) + localError);
+    lows[i / g_rangeBlock] = std::min(lows[i / g_rangeBlock], rates[i]);
+    highs[i / g_rangeBlock] = std::max(highs[i / g_rangeBlock], rates[i]);
+    if (i + 1 < days.size()) {
+      held = static_cast<long double>(rates[i]) * (days[i + 1] - days[i]);
+      addExact(local, localError, held);
+      addExact(base, baseError, held);
+    }
+  }
+  // level k starts at k * blocks and covers runs of 2^k blocks
+  for (width = 1; width * 2 <= blocks; width *= 2) {
+    at = lows.size();
+    lows.resize(at + blocks);
+    highs.resize(at + blocks);
+    for (size_t b = 0; b + width * 2 <= blocks; ++b) {
+      lows[at + b] =
+          std::min(lows[at - blocks + b], lows[at - blocks + b + width]);
+      highs[at + b] =
+          std::max(highs[at - blocks + b], highs[at - blocks + b + width]);
+    }
+  }
+}
+
+// Rate at the end of the given day: that of the last row or tick up to
+// then
+bool RateTable::find(int day, double &rate) const {
+  bool found;
+
+  found = findDaily(day, rate);
+  if (ticks.empty())
+    return (found);
+  return (latest(day, g_secondsPerDay - 1, found, rate, NULL));
+}
+
+bool RateTable::find(int day, double &rate, Cursor &cursor) const {
+  bool found;
+
+  found = findDaily(day, rate, cursor.day);
+  if (ticks.empty())
+    return (found);
+  return (latest(day, g_secondsPerDay - 1, found, rate, &cursor));
+}
+
+// Rate at the given second of day
+bool RateTable::findAt(int day, int seconds, double &rate) const {
+  bool found;
+
+  found = findDaily(day, rate);
+  if (ticks.empty())
+    return (found);
+  return (latest(day, seconds, found, rate, NULL));
+}
+
+// Replaces rate, the daily rate for day if found, with the last tick up
+// to the given second when that tick is not older than the daily row.
+// With a cursor both searches start from where the previous lookup ended.
+bool RateTable::latest(int day, int seconds, bool found, double &rate,
+                       Cursor *cursor) const {
+  int64_t key;
+  int64_t tick;
+  double tickRate;
+  int rowDay;
+
+  key = day * g_secondsPerDay + seconds;
+  if (cursor ? !ticks.find(key, tick, tickRate, cursor->tick)
+             : !ticks.find(key, tick, tickRate))
+    return (found);
+  if (found) {
+    rowDay = days[cursor ? indexOf(day, cursor->day) : indexOf(day)];
+    if (tick < rowDay * g_secondsPerDay)
+      return (true);
+  }
+  rate = tickRate;
+  return (true);
+}
+
+// Rate of the given day, or of the nearest earlier day that has one
+bool RateTable::findDaily(int day, double &rate) const {
+  std::vector<int>::const_iterator it;
+
+  if (days.empty() || day < days.front())
+    return (false);
+  if (day >= days.back()) {
+    rate = rates.back();
+    return (true);
+  }
+  if (!daily.empty()) {
+    rate = daily[day - days.front()];
+    return (true);
+  }
+  it = std::upper_bound(days.begin(), days.end(), day);
+  rate = rates[it - days.begin() - 1];
+  return (true);
+}
+
+// Same as findDaily(), for callers that look up mostly increasing days
+bool RateTable::findDaily(int day, double &rate, size_t &cursor) const {
+  if (!daily.empty() || days.empty() || day < days.front() ||
+      day >= days.back())
+    return (findDaily(day, rate));
+  rate = rates[indexOf(day, cursor)];
+  return (true);
+}
+
+// Average, minimum and maximum of the forward-filled daily rate over the
+// days first to last; false when first has no rate
+bool RateTable::aggregate(int first, int last, double &average, double &low,
+                          double &high) const {
+  size_t from;
+  size_t to;
+  long double total;
+  long double error;
+
+  if (days.empty() || first < days.front() || last < first)
+    return (false);
+  from = indexOf(first);
+  to = indexOf(last);
+  extremes(from, to, low, high);
+  if (from == to) {
+    average = rates[from];
+    return (true);
+  }
+  // The rows both sums share cancel out; what subtracting them rounds off
+  // is kept and added back with the stored errors
+  total = 0;
+  error = 0;
+  addExact(total, error, blockSums[to / g_rangeBlock]);
+  addExact(total, error, -blockSums[from / g_rangeBlock]);
+  addExact(total, error, sums[to]);
+  addExact(total, error, -static_cast<long double>(sums[from]));
+  error += blockErrors[to / g_rangeBlock] - blockErrors[from / g_rangeBlock];
+  error += static_cast<long double>(sumErrors[to]) - sumErrors[from];
+  total += error + static_cast<long double>(rates[to]) * (last + 1 - days[to]) -
+           static_cast<long double>(rates[from]) * (first - days[from]);
+  average = static_cast<double>(
+      total / (static_cast<long double>(last) - first + 1));
+  return (true);
+}
+
+// Last row at or before day, which must not precede the first row
+size_t RateTable::indexOf(int day) const {
+  if (day >= days.back())
+    return (days.size() - 1);
+  if (!dailyRows.empty())
+    return (dailyRows[day - days.front()]);
+  return (std::upper_bound(days.begin(), days.end(), day) - days.begin() - 1);
+}
+
+// Same as indexOf(day) for days that mostly increase: cursor remembers the
+// last index, and the search gallops forward from it, falling back to a
+// full search when the order breaks
+size_t RateTable::indexOf(int day, size_t &cursor) const {
+  size_t low;
+  size_t high;
+  size_t step;
+
+  if (day >= days.back()) {
+    cursor = days.size() - 1;
+    return (cursor);
+  }
+  if (cursor >= days.size() || days[cursor] > day)
+    cursor = 0;
+  low = cursor;
+  step = 1;
+  high = low + step;
+  while (high < days.size() && days[high] <= day) {
+    low = high;
+    step *= 2;
+    high = low + step;
+  }
+  if (high > days.size())
+    high = days.size();
+  // days[low] <= day < days[high]
+  cursor = std::upper_bound(days.begin() + low + 1, days.begin() + high, day) -
+           days.begin() - 1;
+  return (cursor);
+}
+
+void RateTable::extremes(size_t first, size_t last, double &low,
+                         double &high) const {
+  size_t firstBlock;
+  size_t lastBlock;
+  size_t blocks;
+  size_t width;
+  size_t at;
+
+  firstBlock = first / g_rangeBlock;
+  lastBlock = last / g_rangeBlock;
+  low = rates[first];
+  high = rates[first];
+  if (lastBlock - firstBlock < 2) {
+    for (size_t i = first; i <= last; ++i) {
+      low = std::min(low, rates[i]);
+      high = std::max(high, rates[i]);
+    }
+    return;
+  }
+  for (size_t i = first; i < (firstBlock + 1) * g_rangeBlock; ++i) {
+    low = std::min(low, rates[i]);
+    high = std::max(high, rates[i]);
+  }
+  for (size_t i = lastBlock * g_rangeBlock; i <= last; ++i) {
+    low = std::min(low, rates[i]);
+    high = std::max(high, rates[i]);
+  }
+  blocks = blockSums.size();
+  at = 0;
+  for (width = 1; width * 2 <= lastBlock - firstBlock - 1; width *= 2)
+    at += blocks;
+  low = std::min(low, std::min(lows[at + firstBlock + 1],
+                               lows[at + lastBlock - width]));
+  high = std::max(high, std::max(highs[at + firstBlock + 1],
+                                 highs[at + lastBlock - width]));
+}
+
+size_t RateTable::size() const { return (days.size()); }
+
+bool RateTable::empty() const { return (days.empty()); }
+
+const std::vector<int> &RateTable::getDays() const { return (days); }
+
+const std::vector<double> &RateTable::getRates() const { return (rates); }
+
+const TickStore &RateTable::getTicks() const { return (ticks); }
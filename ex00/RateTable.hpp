@@ -0,0 +1,100 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RateTable.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:14:52 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 03:05:53 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RATE_TABLE__HPP
+# define RATE_TABLE__HPP
+# include "TickStore.hpp"
+# include <cstddef>
+# include <stdint.h>
+# include <vector>
+
+// Exchange rates keyed by day number (see BitcoinExchange::parseDate).
+// Days and rates live in two sorted arrays; when the covered range is
+// dense enough, a per-day table with gaps forward-filled answers lookups
+// with a single index, and a second one maps each day to its row.
+//
+// Range aggregates use running sums of rate * days held, split into a
+// long double base per block of rows plus a double offset per row, and
+// sparse tables of per-block minima and maxima. Each sum keeps the error
+// its additions rounded off, so small rates held after a huge one are not
+// lost when two sums are subtracted.
+//
+// Intraday rows go to a TickStore. For lookups a daily row counts as a
+// tick at midnight, and a day on its own means the end of that day.
+//
+// finalize() only rebuilds the indexes from the first row that changed
+// since the last call, so rows added after the last day cost about as
+// much as there are of them; only the per-block minima and maxima are
+// rebuilt whole.
+class RateTable
+{
+  public:
+	RateTable();
+	RateTable(const RateTable &other);
+	RateTable &operator=(const RateTable &other);
+	~RateTable();
+
+	// Where the last lookup landed, for callers whose days mostly increase
+	struct Cursor
+	{
+		Cursor();
+		size_t day;
+		size_t tick;
+	};
+
+	void insert(int day, double rate);
+	void insertTick(int day, int seconds, double rate);
+	void append(const RateTable &rows);
+	void finalize();
+	void clear();
+	bool assign(const int *sortedDays, const double *dayRates, size_t count);
+
+	bool find(int day, double &rate) const;
+	bool find(int day, double &rate, Cursor &cursor) const;
+	bool findAt(int day, int seconds, double &rate) const;
+	bool aggregate(int first, int last, double &average, double &low,
+		double &high) const;
+
+	size_t size() const;
+	bool empty() const;
+	const std::vector<int> &getDays() const;
+	const std::vector<double> &getRates() const;
+	const TickStore &getTicks() const;
+
+  private:
+	std::vector<int> days;
+	std::vector<double> rates;
+	std::vector<double> daily;
+	std::vector<uint32_t> dailyRows;
+	std::vector<long double> blockSums;
+	std::vector<long double> blockErrors;
+	std::vector<double> sums;
+	std::vector<double> sumErrors;
+	std::vector<double> lows;
+	std::vector<double> highs;
+	TickStore ticks;
+	bool sorted;
+	size_t indexed;
+
+	void sortAndMerge();
+	void buildIndexes(size_t from);
+	void buildDaily(size_t from);
+	void buildRanges(size_t from);
+	bool findDaily(int day, double &rate) const;
+	bool findDaily(int day, double &rate, size_t &cursor) const;
+	bool latest(int day, int seconds, bool found, double &rate,
+		Cursor *cursor) const;
+	size_t indexOf(int day) const;
+	size_t indexOf(int day, size_t &cursor) const;
+	void extremes(size_t first, size_t last, double &low, double &high) const;
+};
+#endif
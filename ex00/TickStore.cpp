@@ -0,0 +1,217 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TickStore.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:32:46 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 02:58:53 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "TickStore.hpp"
+#include <algorithm>
+
+static const size_t g_tickBlock = 64;
+
+TickStore::TickStore() : lastKey(0) {}
+
+TickStore::TickStore(const TickStore &other)
+    : blockKeys(other.blockKeys), blockOffsets(other.blockOffsets),
+      deltas(other.deltas), rates(other.rates), pending(other.pending),
+      lastKey(other.lastKey) {}
+
+TickStore &TickStore::operator=(const TickStore &other) {
+  if (this != &other) {
+    blockKeys = other.blockKeys;
+    blockOffsets = other.blockOffsets;
+    deltas = other.deltas;
+    rates = other.rates;
+    pending = other.pending;
+    lastKey = other.lastKey;
+  }
+  return (*this);
+}
+
+TickStore::~TickStore() {}
+
+// Queued until finalize(); a later tick with the same key wins
+void TickStore::insert(int64_t key, double rate) {
+  pending.push_back(std::make_pair(key, rate));
+}
+
+// Queues the ticks other has not finalized yet
+void TickStore::append(const TickStore &other) {
+  pending.insert(pending.end(), other.pending.begin(), other.pending.end());
+}
+
+static bool lessKey(const std::pair<int64_t, double> &a,
+                    const std::pair<int64_t, double> &b) {
+  return (a.first < b.first);
+}
+
+// Queued ticks that all come after the stored ones are encoded onto the
+// end; otherwise everything is decoded, merged and encoded again
+void TickStore::finalize() {
+  std::vector<std::pair<int64_t, double> > ticks;
+  size_t out;
+
+  if (pending.empty())
+    return;
+  ticks.swap(pending);
+  std::stable_sort(ticks.begin(), ticks.end(), lessKey);
+  if (!rates.empty() && ticks.front().first <= lastKey) {
+    std::vector<std::pair<int64_t, double> > stored;
+    decodeAll(stored);
+    stored.insert(stored.end(), ticks.begin(), ticks.end());
+    std::stable_sort(stored.begin(), stored.end(), lessKey);
+    stored.swap(ticks);
+  }
+  out = 0;
+  for (size_t i = 0; i < ticks.size(); ++i) {
+    if (out > 0 && ticks[out - 1].first == ticks[i].first)
+      --out;
+    ticks[out++] = ticks[i];
+  }
+  ticks.resize(out);
+  if (!rates.empty() && ticks.front().first > lastKey)
+    encodeTail(ticks);
+  else
+    encode(ticks);
+}
+
+void TickStore::clear() {
+  blockKeys.clear();
+  blockOffsets.clear();
+  deltas.clear();
+  rates.clear();
+  pending.clear();
+}
+
+static uint64_t readVarint(const unsigned char *&p) {
+  uint64_t value;
+  unsigned shift;
+
+  value = 0;
+  shift = 0;
+  while (*p & 0x80) {
+    value |= static_cast<uint64_t>(*p++ & 0x7f) << shift;
+    shift += 7;
+  }
+  return (value | static_cast<uint64_t>(*p++) << shift);
+}
+
+// Last tick at or before key
+bool TickStore::find(int64_t key, int64_t &found, double &rate) const {
+  std::vector<int64_t>::const_iterator it;
+
+  it = std::upper_bound(blockKeys.begin(), blockKeys.end(), key);
+  if (it == blockKeys.begin())
+    return (false);
+  scanBlock(it - blockKeys.begin() - 1, key, found, rate);
+  return (true);
+}
+
+// Same as find(), for keys that mostly increase: cursor remembers the last
+// block, and the search gallops forward from it, falling back to a full
+// search when the order breaks
+bool TickStore::find(int64_t key, int64_t &found, double &rate,
+                     size_t &cursor) const {
+  size_t low;
+  size_t high;
+  size_t step;
+
+  if (blockKeys.empty() || key < blockKeys.front())
+    return (false);
+  if (cursor >= blockKeys.size() || blockKeys[cursor] > key)
+    cursor = 0;
+  low = cursor;
+  step = 1;
+  high = low + step;
+  while (high < blockKeys.size() && blockKeys[high] <= key) {
+    low = high;
+    step *= 2;
+    high = low + step;
+  }
+  if (high > blockKeys.size())
+    high = blockKeys.size();
+  // blockKeys[low] <= key < blockKeys[high]
+  cursor = std::upper_bound(blockKeys.begin() + low + 1,
+                            blockKeys.begin() + high, key) -
+           blockKeys.begin() - 1;
+  scanBlock(cursor, key, found, rate);
+  return (true);
+}
+
+// Last tick at or before key within block, whose first key is at most key
+void TickStore::scanBlock(size_t block, int64_t key, int64_t &found,
+                          double &rate) const {
+  const unsigned char *p;
+  size_t index;
+  size_t end;
+  int64_t next;
+
+  index = block * g_tickBlock;
+  end = std::min(index + g_tickBlock, rates.size());
+  found = blockKeys[block];
+  p = deltas.empty() ? NULL : &deltas[0] + blockOffsets[block];
+  while (index + 1 < end) {
+    next = found + static_cast<int64_t>(readVarint(p));
+    if (next > key)
+      break;
+    found = next;
+    ++index;
+  }
+  rate = rates[index];
+}
+
+size_t TickStore::size() const { return (rates.size()); }
+
+bool TickStore::empty() const { return (rates.empty()); }
+
+void TickStore::decodeAll(
+    std::vector<std::pair<int64_t, double> > &ticks) const {
+  const unsigned char *p;
+  int64_t key;
+
+  ticks.resize(rates.size());
+  key = 0;
+  p = deltas.empty() ? NULL : &deltas[0];
+  for (size_t i = 0; i < rates.size(); ++i) {
+    if (i % g_tickBlock == 0)
+      key = blockKeys[i / g_tickBlock];
+    else
+      key += static_cast<int64_t>(readVarint(p));
+    ticks[i] = std::make_pair(key, rates[i]);
+  }
+}
+
+// ticks must be sorted with distinct keys
+void TickStore::encode(const std::vector<std::pair<int64_t, double> > &ticks) {
+  clear();
+  encodeTail(ticks);
+  std::vector<unsigned char>(deltas).swap(deltas);
+}
+
+// ticks are sorted, distinct and all after lastKey
+void TickStore::encodeTail(
+    const std::vector<std::pair<int64_t, double> > &ticks) {
+  uint64_t delta;
+
+  for (size_t i = 0; i < ticks.size(); ++i) {
+    if (rates.size() % g_tickBlock == 0) {
+      blockKeys.push_back(ticks[i].first);
+      blockOffsets.push_back(static_cast<uint32_t>(deltas.size()));
+    } else {
+      delta = static_cast<uint64_t>(ticks[i].first - lastKey);
+      while (delta >= 0x80) {
+        deltas.push_back(static_cast<unsigned char>(delta | 0x80));
+        delta >>= 7;
+      }
+      deltas.push_back(static_cast<unsigned char>(delta));
+    }
+    rates.push_back(ticks[i].second);
+    lastKey = ticks[i].first;
+  }
+}
@@ -0,0 +1,59 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TickStore.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:32:46 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 02:58:53 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TICK_STORE__HPP
+# define TICK_STORE__HPP
+# include <cstddef>
+# include <stdint.h>
+# include <utility>
+# include <vector>
+
+// Intraday rates keyed by seconds since 1970-01-01 00:00:00. Keys and
+// rates are stored as separate columns: keys are cut into blocks of 64,
+// each block holding its first key in a small index and the following
+// keys as LEB128 deltas, so a lookup decodes a single block. Rates stay
+// plain doubles.
+class TickStore
+{
+  public:
+	TickStore();
+	TickStore(const TickStore &other);
+	TickStore &operator=(const TickStore &other);
+	~TickStore();
+
+	void insert(int64_t key, double rate);
+	void append(const TickStore &other);
+	void finalize();
+	void clear();
+
+	bool find(int64_t key, int64_t &found, double &rate) const;
+	bool find(int64_t key, int64_t &found, double &rate,
+		size_t &cursor) const;
+
+	size_t size() const;
+	bool empty() const;
+
+  private:
+	std::vector<int64_t> blockKeys;
+	std::vector<uint32_t> blockOffsets;
+	std::vector<unsigned char> deltas;
+	std::vector<double> rates;
+	std::vector<std::pair<int64_t, double> > pending;
+	int64_t lastKey;
+
+	void scanBlock(size_t block, int64_t key, int64_t &found,
+		double &rate) const;
+	void decodeAll(std::vector<std::pair<int64_t, double> > &ticks) const;
+	void encode(const std::vector<std::pair<int64_t, double> > &ticks);
+	void encodeTail(const std::vector<std::pair<int64_t, double> > &ticks);
+};
+#endif
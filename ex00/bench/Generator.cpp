@@ -0,0 +1,185 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Generator.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:28:19 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:28:19 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Generator.hpp"
+#include <algorithm>
+
+static const int g_firstDay = 14246; // 2009-01-02
+static const size_t g_clusterSize = 64;
+
+Generator::Generator() : state(0x9e3779b97f4a7c15ull) {}
+
+Generator::Generator(uint64_t seed)
+    : state(seed ? seed : 0x9e3779b97f4a7c15ull) {}
+
+Generator::Generator(const Generator &other) : state(other.state) {}
+
+Generator &Generator::operator=(const Generator &other) {
+  if (this != &other)
+    this->state = other.state;
+  return (*this);
+}
+
+Generator::~Generator() {}
+
+bool Generator::parseOrder(const std::string &str, Order &order) {
+  if (str == "sorted")
+    order = SORTED;
+  else if (str == "shuffled")
+    order = SHUFFLED;
+  else if (str == "clustered")
+    order = CLUSTERED;
+  else
+    return (false);
+  return (true);
+}
+
+const char *Generator::orderName(Order order) {
+  if (order == SHUFFLED)
+    return ("shuffled");
+  if (order == CLUSTERED)
+    return ("clustered");
+  return ("sorted");
+}
+
+void Generator::writeDatabase(std::FILE *out, size_t rows, Order order,
+                              double errors) {
+  std::vector<uint32_t> days(rows);
+  std::vector<double> rates(rows);
+  double rate;
+
+  rate = 0.3;
+  for (size_t i = 0; i < rows; ++i) {
+    days[i] = i;
+    rate *= 0.97 + 0.0605 * uniform();
+    if (rate < 0.01)
+      rate = 0.01;
+    rates[i] = rate;
+  }
+  arrange(days, order);
+  std::fputs("date,exchange_rate\n", out);
+  for (size_t i = 0; i < rows; ++i) {
+    if (uniform() < errors) {
+      switch (below(4)) {
+      case 0:
+        std::fputs("2011-13-01,1.00\n", out);
+        break;
+      case 1:
+        std::fputs("2011-01-01 1.00\n", out);
+        break;
+      case 2:
+        std::fputs("2011-01-01,rate\n", out);
+        break;
+      default:
+        std::fputs("2011-01-01,-1.00\n", out);
+      }
+      continue;
+    }
+    writeDate(out, g_firstDay + days[i]);
+    std::fprintf(out, ",%.2f\n", rates[days[i]]);
+  }
+}
+
+void Generator::writeInput(std::FILE *out, size_t lines, size_t span,
+                           Order order, double errors) {
+  std::vector<uint32_t> days(lines);
+
+  for (size_t i = 0; i < lines; ++i)
+    days[i] = below(span);
+  if (order != SHUFFLED)
+    std::sort(days.begin(), days.end());
+  arrange(days, order);
+  std::fputs("date | value\n", out);
+  for (size_t i = 0; i < lines; ++i) {
+    if (uniform() < errors) {
+      switch (below(5)) {
+      case 0:
+        std::fputs("2011-02-30 | 1\n", out);
+        break;
+      case 1:
+        std::fputs("2011-01-03 | -1\n", out);
+        break;
+      case 2:
+        std::fputs("2011-01-03 | 2147483648\n", out);
+        break;
+      case 3:
+        std::fputs("2011-01-03 => 1\n", out);
+        break;
+      default:
+        std::fputs("2001-01-01 | 1\n", out);
+      }
+      continue;
+    }
+    writeDate(out, g_firstDay + days[i]);
+    if (below(3) == 0)
+      std::fprintf(out, " | %u\n", static_cast<unsigned>(below(1001)));
+    else
+      std::fprintf(out, " | %.2f\n", uniform() * 1000.0);
+  }
+}
+
+// xorshift64*
+uint64_t Generator::next() {
+  this->state ^= this->state >> 12;
+  this->state ^= this->state << 25;
+  this->state ^= this->state >> 27;
+  return (this->state * 0x2545f4914f6cdd1dull);
+}
+
+size_t Generator::below(size_t bound) {
+  return (bound ? static_cast<size_t>(next() % bound) : 0);
+}
+
+double Generator::uniform() {
+  return ((next() >> 11) * (1.0 / 9007199254740992.0));
+}
+
+// Sorted input is left alone; clustered input keeps runs of consecutive
+// days together but visits the full runs in random order
+void Generator::arrange(std::vector<uint32_t> &days, Order order) {
+  size_t runs;
+  size_t pick;
+
+  if (order == SHUFFLED) {
+    for (size_t i = days.size(); i > 1; --i)
+      std::swap(days[i - 1], days[below(i)]);
+  } else if (order == CLUSTERED) {
+    runs = days.size() / g_clusterSize;
+    for (size_t i = runs; i > 1; --i) {
+      pick = below(i);
+      if (pick == i - 1)
+        continue;
+      std::swap_ranges(days.begin() + pick * g_clusterSize,
+                       days.begin() + (pick + 1) * g_clusterSize,
+                       days.begin() + (i - 1) * g_clusterSize);
+    }
+  }
+}
+
+void Generator::writeDate(std::FILE *out, int day) {
+  int era;
+  unsigned doe;
+  unsigned yoe;
+  unsigned doy;
+  unsigned mp;
+  int year;
+
+  day += 719468;
+  era = day / 146097;
+  doe = static_cast<unsigned>(day - era * 146097);
+  yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  mp = (5 * doy + 2) / 153;
+  year = static_cast<int>(yoe) + era * 400 + (mp >= 10);
+  std::fprintf(out, "%04d-%02u-%02u", year, mp < 10 ? mp + 3 : mp - 9,
+               doy - (153 * mp + 2) / 5 + 1);
+}
@@ -0,0 +1,65 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Generator.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:28:04 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:28:04 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef GENERATOR__HPP
+# define GENERATOR__HPP
+# include <cstddef>
+# include <cstdio>
+# include <stdint.h>
+# include <string>
+# include <vector>
+
+// Deterministic rate databases and input files for the benchmarks. The
+// same seed always produces the same bytes, so two builds can be timed on
+// identical data.
+class Generator
+{
+  public:
+	enum Order
+	{
+		SORTED,
+		SHUFFLED,
+		CLUSTERED
+	};
+	// Days from 2009-01-02 up to 9999-12-31
+	enum
+	{
+		MAX_DAYS = 2918650
+	};
+
+	Generator();
+	explicit Generator(uint64_t seed);
+	Generator(const Generator &other);
+	Generator &operator=(const Generator &other);
+	~Generator();
+
+	static bool parseOrder(const std::string &str, Order &order);
+	static const char *orderName(Order order);
+
+	// One row per day starting at 2009-01-02, at most MAX_DAYS rows
+	void writeDatabase(std::FILE *out, size_t rows, Order order,
+		double errors);
+	// Lines dated within the first span days of the database (span must
+	// not exceed MAX_DAYS)
+	void writeInput(std::FILE *out, size_t lines, size_t span, Order order,
+		double errors);
+
+  private:
+	uint64_t state;
+
+	uint64_t next();
+	size_t below(size_t bound);
+	double uniform();
+	void arrange(std::vector<uint32_t> &days, Order order);
+	static void writeDate(std::FILE *out, int day);
+};
+#endif
@@ -0,0 +1,310 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench.cpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:28:57 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:35:43 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../BitcoinExchange.hpp"
+#include "../Profile.hpp"
+#include "Generator.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+struct Options
+{
+	unsigned long long	rows;
+	unsigned long long	lines;
+	unsigned long long	seed;
+	unsigned long long	runs;
+	unsigned long long	workers;
+	double				errors;
+	bool				quiet;
+	std::vector<Generator::Order>	orders;
+	std::string			dir;
+};
+
+struct Sample
+{
+	uint64_t	phases[Profile::PHASES];
+	uint64_t	wall;
+	long		peakRss;
+};
+
+static bool	parseSize(const char *str, unsigned long long &value)
+{
+	char	*end;
+
+	if (*str < '0' || *str > '9')
+		return (false);
+	value = std::strtoull(str, &end, 10);
+	return (*end == '\0');
+}
+
+static int	usage()
+{
+	std::cerr << "usage: btc_bench [--rows N] [--lines N] "
+		<< "[--order sorted|shuffled|clustered|all]\n"
+		<< "                 [--errors RATIO] [--seed N] [--runs N] [-j N] "
+		<< "[--dir DIR] [-q]" << std::endl;
+	return (1);
+}
+
+static bool	parseOptions(int argc, char **argv, Options &opt)
+{
+	Generator::Order	order;
+	std::string			name;
+	char				*end;
+
+	opt.rows = 100000;
+	opt.lines = 1000000;
+	opt.seed = 42;
+	opt.runs = 3;
+	opt.workers = 1;
+	opt.errors = 0.05;
+	opt.quiet = false;
+	for (int i = 1; i < argc; i += 2)
+	{
+		name = argv[i];
+		if (name == "-q")
+		{
+			opt.quiet = true;
+			--i;
+			continue;
+		}
+		if (i + 1 >= argc)
+			return (false);
+		if (name == "--rows")
+		{
+			if (!parseSize(argv[i + 1], opt.rows) || opt.rows == 0
+				|| opt.rows > Generator::MAX_DAYS)
+				return (false);
+		}
+		else if (name == "--lines")
+		{
+			if (!parseSize(argv[i + 1], opt.lines))
+				return (false);
+		}
+		else if (name == "--seed")
+		{
+			if (!parseSize(argv[i + 1], opt.seed))
+				return (false);
+		}
+		else if (name == "--runs")
+		{
+			if (!parseSize(argv[i + 1], opt.runs) || opt.runs == 0)
+				return (false);
+		}
+		else if (name == "-j")
+		{
+			if (!parseSize(argv[i + 1], opt.workers) || opt.workers > 1024)
+				return (false);
+		}
+		else if (name == "--errors")
+		{
+			opt.errors = std::strtod(argv[i + 1], &end);
+			if (*end != '\0' || !(opt.errors >= 0.0 && opt.errors <= 1.0))
+				return (false);
+		}
+		else if (name == "--order")
+		{
+			if (std::string(argv[i + 1]) == "all")
+				opt.orders.clear();
+			else if (Generator::parseOrder(argv[i + 1], order))
+				opt.orders.push_back(order);
+			else
+				return (false);
+		}
+		else if (name == "--dir")
+			opt.dir = argv[i + 1];
+		else
+			return (false);
+	}
+	if (opt.orders.empty())
+	{
+		opt.orders.push_back(Generator::SORTED);
+		opt.orders.push_back(Generator::SHUFFLED);
+		opt.orders.push_back(Generator::CLUSTERED);
+	}
+	return (true);
+}
+
+static bool	writeFile(const std::string &path, const Options &opt,
+	Generator::Order order, bool database)
+{
+	std::FILE	*out;
+	Generator	generator(opt.seed);
+	bool		ok;
+
+	out = std::fopen(path.c_str(), "w");
+	if (!out)
+		return (false);
+	if (database)
+		generator.writeDatabase(out, opt.rows, Generator::SORTED, 0.0);
+	else
+		generator.writeInput(out, opt.lines, opt.rows, order, opt.errors);
+	ok = !std::ferror(out);
+	return (std::fclose(out) == 0 && ok);
+}
+
+// Runs one load and query pass in a child process so that every sample
+// gets its own peak RSS. The child reports its timings through a pipe.
+static bool	measure(const Options &opt, const std::string &input,
+	Sample &sample)
+{
+	struct rusage	usage;
+	int				fds[2];
+	int				status;
+	int				null;
+	pid_t			pid;
+	ssize_t			got;
+
+	if (pipe(fds) != 0)
+		return (false);
+	pid = fork();
+	if (pid < 0)
+		return (false);
+	if (pid == 0)
+	{
+		close(fds[0]);
+		null = open("/dev/null", O_WRONLY);
+		if (null < 0 || dup2(null, 1) < 0 || dup2(null, 2) < 0)
+			_exit(1);
+		try
+		{
+			BitcoinExchange	btc;
+			uint64_t		start;
+
+			btc.setWorkers(opt.workers);
+			btc.setQuiet(opt.quiet);
+			Profile::reset();
+			start = Profile::now();
+			btc.loadDatabase(opt.dir + "/data.csv");
+			btc.processInput(input);
+			sample.wall = Profile::now() - start;
+		}
+		catch (std::exception &)
+		{
+			_exit(1);
+		}
+		for (int i = 0; i < Profile::PHASES; ++i)
+			sample.phases[i] = Profile::total(static_cast<Profile::Phase>(i));
+		if (write(fds[1], &sample, sizeof(sample)) != sizeof(sample))
+			_exit(1);
+		_exit(0);
+	}
+	close(fds[1]);
+	do
+		got = read(fds[0], &sample, sizeof(sample));
+	while (got < 0 && errno == EINTR);
+	close(fds[0]);
+	if (wait4(pid, &status, 0, &usage) != pid || !WIFEXITED(status)
+		|| WEXITSTATUS(status) != 0 || got != sizeof(sample))
+		return (false);
+	sample.peakRss = usage.ru_maxrss;
+	return (true);
+}
+
+static double	millis(uint64_t nanoseconds)
+{
+	return (nanoseconds / 1e6);
+}
+
+static void	report(Generator::Order order, const Options &opt, off_t bytes,
+	const Sample &best)
+{
+	double	seconds;
+
+	seconds = best.wall / 1e9;
+	std::printf("%-10s %9llu %8.1f", Generator::orderName(order), opt.lines,
+		bytes / 1e6);
+	for (int i = 0; i < Profile::PHASES; ++i)
+		std::printf(" %8.1f", millis(best.phases[i]));
+	std::printf(" %8.1f %9.2f %8.1f %8.1f\n", millis(best.wall),
+		opt.lines / seconds / 1e6, bytes / seconds / 1e6,
+		best.peakRss / 1024.0);
+	std::fflush(stdout);
+}
+
+int	main(int argc, char **argv)
+{
+	Options		opt;
+	Sample		sample;
+	Sample		best;
+	struct stat	st;
+	bool		temporary;
+	char		pattern[] = "/tmp/btc_bench.XXXXXX";
+	std::string	input;
+
+	if (!parseOptions(argc, argv, opt))
+		return (usage());
+	temporary = opt.dir.empty();
+	if (temporary)
+	{
+		if (!mkdtemp(pattern))
+		{
+			std::cerr << "Error: could not create a data directory" << std::endl;
+			return (1);
+		}
+		opt.dir = pattern;
+	}
+	if (!writeFile(opt.dir + "/data.csv", opt, Generator::SORTED, true))
+	{
+		std::cerr << "Error: could not write the database" << std::endl;
+		return (1);
+	}
+	std::printf("database: %llu rows, workers: %llu, errors: %.2f%s, "
+		"seed: %llu, best of %llu runs\n", opt.rows, opt.workers, opt.errors,
+		opt.quiet ? " (quiet)" : "", opt.seed, opt.runs);
+	std::printf("%-10s %9s %8s %8s %8s %8s %8s %8s %9s %8s %8s\n", "order",
+		"lines", "MB", "load", "parse", "lookup", "output", "wall",
+		"Mlines/s", "MB/s", "RSS MB");
+	for (size_t i = 0; i < opt.orders.size(); ++i)
+	{
+		input = opt.dir + "/input_" + Generator::orderName(opt.orders[i])
+			+ ".txt";
+		if (!writeFile(input, opt, opt.orders[i], false)
+			|| stat(input.c_str(), &st) != 0)
+		{
+			std::cerr << "Error: could not write " << input << std::endl;
+			return (1);
+		}
+		std::memset(&best, 0, sizeof(best));
+		for (unsigned long long run = 0; run < opt.runs; ++run)
+		{
+			if (!measure(opt, input, sample))
+			{
+				std::cerr << "Error: benchmark run failed" << std::endl;
+				return (1);
+			}
+			if (run == 0 || sample.wall < best.wall)
+				best = sample;
+		}
+		report(opt.orders[i], opt, st.st_size, best);
+		if (temporary)
+			unlink(input.c_str());
+	}
+	if (temporary)
+	{
+		unlink((opt.dir + "/data.csv").c_str());
+		rmdir(opt.dir.c_str());
+	}
+	std::printf("times in ms; parse, lookup and output are summed over "
+		"all workers\n");
+	return (0);
+}
@@ -0,0 +1,96 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   generate.cpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:28:32 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:28:32 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Generator.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+static bool	parseSize(const char *str, unsigned long long &value)
+{
+	char	*end;
+
+	if (*str < '0' || *str > '9')
+		return (false);
+	value = std::strtoull(str, &end, 10);
+	return (*end == '\0');
+}
+
+static int	usage()
+{
+	std::cerr << "usage: generate db ROWS [-o ORDER] [-e RATIO] [-s SEED]\n"
+		<< "       generate input LINES SPAN [-o ORDER] [-e RATIO] [-s SEED]\n"
+		<< "ORDER is sorted, shuffled or clustered" << std::endl;
+	return (1);
+}
+
+int	main(int argc, char **argv)
+{
+	Generator::Order	order;
+	unsigned long long	count;
+	unsigned long long	span;
+	unsigned long long	seed;
+	double				errors;
+	char				*end;
+	int					arg;
+	static char			buffer[1 << 16];
+
+	if (argc < 3 || !parseSize(argv[2], count))
+		return (usage());
+	if (std::string(argv[1]) == "db" && count > Generator::MAX_DAYS)
+		return (usage());
+	span = 0;
+	arg = 3;
+	if (std::string(argv[1]) == "input")
+	{
+		if (argc < 4 || !parseSize(argv[3], span) || span == 0
+			|| span > Generator::MAX_DAYS)
+			return (usage());
+		arg = 4;
+	}
+	else if (std::string(argv[1]) != "db")
+		return (usage());
+	order = Generator::SORTED;
+	errors = 0.0;
+	seed = 42;
+	for (; arg + 1 < argc; arg += 2)
+	{
+		if (std::string(argv[arg]) == "-o")
+		{
+			if (!Generator::parseOrder(argv[arg + 1], order))
+				return (usage());
+		}
+		else if (std::string(argv[arg]) == "-e")
+		{
+			errors = std::strtod(argv[arg + 1], &end);
+			if (*end != '\0' || !(errors >= 0.0 && errors <= 1.0))
+				return (usage());
+		}
+		else if (std::string(argv[arg]) == "-s")
+		{
+			if (!parseSize(argv[arg + 1], seed))
+				return (usage());
+		}
+		else
+			return (usage());
+	}
+	if (arg != argc)
+		return (usage());
+	std::setvbuf(stdout, buffer, _IOFBF, sizeof(buffer));
+	Generator	generator(seed);
+	if (span == 0)
+		generator.writeDatabase(stdout, count, order, errors);
+	else
+		generator.writeInput(stdout, count, span, order, errors);
+	return (std::fflush(stdout) == 0 ? 0 : 1);
+}
@@ -6,30 +6,107 @@
 /*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/02/09 12:46:31 by igngonza          #+#    #+#             */
-/*   Updated: 2026/03/04 11:15:21 by igngonza         ###   ########.fr       */
+/*   Updated: 2026/10/18 02:32:22 by igngonza         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "BitcoinExchange.hpp"
+#include "Profile.hpp"
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <string>
+
+static bool	parseWorkers(const char *str, size_t &workers)
+{
+	char	*end;
+	long	value;
+
+	value = std::strtol(str, &end, 10);
+	if (*str == '\0' || *end != '\0' || value < 0 || value > 1024)
+		return (false);
+	workers = static_cast<size_t>(value);
+	return (true);
+}
+
+static bool	writeSummary(const char *path)
+{
+	std::ofstream	file(path);
+
+	file << Profile::summary();
+	file.close();
+	if (!file)
+	{
+		std::cerr << "Error: could not write the summary file." << std::endl;
+		return (false);
+	}
+	return (true);
+}
 
 int	main(int argc, char **argv)
 {
 	BitcoinExchange	btc;
+	std::string		option;
+	const char		*summary;
+	size_t			workers;
+	int				arg;
 
-	if (argc != 2)
+	arg = 1;
+	summary = NULL;
+	while (arg < argc)
+	{
+		option = argv[arg];
+		if (option == "-q")
+		{
+			btc.setQuiet(true);
+			arg += 1;
+			continue;
+		}
+		if ((option != "-j" && option != "--json") || arg + 1 >= argc)
+			break;
+		if (option == "--json")
+			summary = argv[arg + 1];
+		else if (!parseWorkers(argv[arg + 1], workers))
+		{
+			std::cerr << "Error: invalid worker count." << std::endl;
+			return (1);
+		}
+		else
+			btc.setWorkers(workers);
+		arg += 2;
+	}
+	if (argc - arg < 1 || argc - arg > 2
+		|| (argc - arg == 2 && std::string(argv[arg]) != "--stream"
+			&& std::string(argv[arg]) != "--serve"))
 	{
 		std::cerr << "Error: could not open file." << std::endl;
 		return (1);
 	}
+	if (argc - arg == 1 && std::string(argv[arg]) == "--serve")
+	{
+		std::cerr << "Error: --serve needs a socket path." << std::endl;
+		return (1);
+	}
 	try
 	{
-		btc.loadDatabase("data.csv");
-		btc.processInput(argv[1]);
+		if (std::string(argv[arg]) == "--snapshot")
+			btc.saveSnapshot("data.csv");
+		else
+		{
+			btc.loadDatabase("data.csv");
+			if (std::string(argv[arg]) == "--stream")
+				btc.streamInput(arg + 1 < argc ? argv[arg + 1] : "");
+			else if (std::string(argv[arg]) == "--serve")
+				btc.serve(argv[arg + 1]);
+			else
+				btc.processInput(argv[arg]);
+		}
 	}
 	catch (std::exception &e)
 	{
 		std::cerr << e.what() << std::endl;
 	}
+	if (summary && !writeSummary(summary))
+		return (1);
 	return (0);
 }
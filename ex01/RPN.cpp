@@ -6,14 +6,14 @@
 /*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/02/10 12:14:34 by igngonza          #+#    #+#             */
-/*   Updated: 2026/03/09 11:20:02 by igngonza         ###   ########.fr       */
+/*   Updated: 2026/10/18 02:52:28 by igngonza         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "RPN.hpp"
-#include <sstream>
-#include <stack>
+#include <cctype>
 #include <stdexcept>
+#include <vector>
 
 RPN::RPN() {}
 
@@ -26,18 +26,24 @@ RPN &RPN::operator=(const RPN &other) {
 
 RPN::~RPN() {}
 
-bool RPN::isOperator(const std::string &token) const {
-  return (token == "+" || token == "-" || token == "*" || token == "/");
+// Stack evaluate(const std::string &) keeps on the call stack. Only an
+// expression deeper than this allocates one
+static const size_t g_stackCapacity = 1024;
+static const char g_stackOverflow[] = "stack overflow";
+
+static bool isSpace(char c) {
+  return std::isspace(static_cast<unsigned char>(c)) != 0;
 }
 
-int RPN::applyOperation(int a, int b, const std::string &op) const {
-  if (op == "+")
+int RPN::applyOperation(int a, int b, char op) const {
+  switch (op) {
+  case '+':
     return a + b;
-  if (op == "-")
+  case '-':
     return a - b;
-  if (op == "*")
+  case '*':
     return a * b;
-  if (op == "/") {
+  case '/':
     if (b == 0)
       throw std::runtime_error("division by zero");
     return a / b;
@@ -45,30 +51,133 @@ int RPN::applyOperation(int a, int b, const std::string &op) const {
   throw std::runtime_error("invalid operator");
 }
 
+// Every token is one byte, so the stack never holds more than
+// (len + 1) / 2 numbers. An expression that overflows the local stack is
+// run again on a heap stack of that size.
 int RPN::evaluate(const std::string &expr) const {
-  std::stack<int> s;
-  std::stringstream ss(expr);
-  std::string token;
-
-  while (ss >> token) {
-    if (token.size() == 1 && std::isdigit(token[0]))
-      s.push(token[0] - '0');
-    else if (isOperator(token)) {
-      if (s.size() < 2)
-        throw std::runtime_error("invalid expression");
-
-      int b = s.top();
-      s.pop();
-      int a = s.top();
-      s.pop();
-
-      s.push(applyOperation(a, b, token));
+  int local[g_stackCapacity];
+  const char *error;
+  int result;
+
+  error = tryEvaluate(expr.data(), expr.size(), local, g_stackCapacity,
+                      result);
+  if (error == g_stackOverflow) {
+    std::vector<int> stack((expr.size() + 1) / 2);
+    error = tryEvaluate(expr.data(), expr.size(), &stack[0], stack.size(),
+                        result);
+  }
+  if (error)
+    throw std::runtime_error(error);
+  return result;
+}
+
+// evaluate() on a caller-provided stack of capacity ints; running out of
+// it is reported as "stack overflow"
+int RPN::evaluate(const char *expr, size_t len, int *stack,
+                  size_t capacity) const {
+  const char *error;
+  int result;
+
+  error = tryEvaluate(expr, len, stack, capacity, result);
+  if (error)
+    throw std::runtime_error(error);
+  return result;
+}
+
+// One pass over the bytes: a token is a run of non-space characters, and
+// operators dispatch on their single byte. Returns NULL and sets result,
+// or returns the error message evaluate() would throw.
+const char *RPN::tryEvaluate(const char *expr, size_t len, int *stack,
+                             size_t capacity, int &result) const {
+  const char *p;
+  const char *end;
+  size_t size;
+  char c;
+
+  p = expr;
+  end = expr + len;
+  size = 0;
+  while (true) {
+    while (p < end && isSpace(*p))
+      ++p;
+    if (p == end)
+      break;
+    c = *p++;
+    if (p < end && !isSpace(*p))
+      return "invalid token";
+    if (c >= '0' && c <= '9') {
+      if (size == capacity)
+        return g_stackOverflow;
+      stack[size++] = c - '0';
+    } else if (c == '+' || c == '-' || c == '*' || c == '/') {
+      if (size < 2)
+        return "invalid expression";
+      --size;
+      if (c == '/' && stack[size] == 0)
+        return "division by zero";
+      stack[size - 1] = applyOperation(stack[size - 1], stack[size], c);
     } else
-      throw std::runtime_error("invalid token");
+      return "invalid token";
   }
+  if (size != 1)
+    return "invalid expression";
+  result = stack[0];
+  return NULL;
+}
+
+RPN::Program RPN::compile(const std::string &expr) const {
+  return Program(expr);
+}
+
+int RPN::evaluate(const Program &program, Bindings &bindings) const {
+  const Program::Instruction *ip;
+  const Program::Instruction *end;
+  const int *values;
+  int *stack;
 
-  if (s.size() != 1)
+  if (program.size() == 0)
     throw std::runtime_error("invalid expression");
+  if (bindings.size() != program.variableCount())
+    throw std::runtime_error("bindings do not match the program");
+  ip = program.code();
+  end = ip + program.size();
+  values = bindings.values();
+  stack = bindings.scratch(program.maxDepth());
+  for (; ip != end; ++ip) {
+    switch (ip->opcode) {
+    case Program::PUSH:
+      stack[ip->depth] = ip->operand;
+      break;
+    case Program::LOAD:
+      stack[ip->depth] = values[ip->operand];
+      break;
+    case Program::ADD:
+      stack[ip->depth - 2] += stack[ip->depth - 1];
+      break;
+    case Program::SUB:
+      stack[ip->depth - 2] -= stack[ip->depth - 1];
+      break;
+    case Program::MUL:
+      stack[ip->depth - 2] *= stack[ip->depth - 1];
+      break;
+    default:
+      if (stack[ip->depth - 1] == 0)
+        throw std::runtime_error("division by zero");
+      stack[ip->depth - 2] /= stack[ip->depth - 1];
+    }
+  }
+  return stack[0];
+}
+
+RPN::Jit RPN::jit(const Program &program) const { return Jit(program); }
+
+int RPN::evaluate(const Jit &jit, Bindings &bindings) const {
+  Jit::Function function;
+  int result;
 
-  return s.top();
+  function = jit.function();
+  if (function && bindings.size() == jit.program().variableCount() &&
+      function(bindings.values(), &result) == 0)
+    return result;
+  return evaluate(jit.program(), bindings);
 }
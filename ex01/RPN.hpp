@@ -6,25 +6,51 @@
 /*   By: igngonza <igngonza@student.42madrid.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/02/10 12:14:31 by igngonza          #+#    #+#             */
-/*   Updated: 2026/02/10 12:46:34 by igngonza         ###   ########.fr       */
+/*   Updated: 2026/10/18 02:30:06 by igngonza         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef RPN__HPP
 #define RPN__HPP
+#include "RPNJit.hpp"
+#include "RPNProgram.hpp"
+#include <cstddef>
 #include <string>
 
 class RPN {
   public:
+    typedef RPNProgram Program;
+    typedef RPNBindings Bindings;
+    typedef RPNJit Jit;
+
+    // Number types for evaluate(expr, mode), which also takes literals of
+    // more than one digit
+    enum Arithmetic { CHECKED_INT64, RATIONAL, BIG_INTEGER };
+
     RPN();
     RPN(const RPN &other);
     RPN &operator=(const RPN &other);
     ~RPN();
 
     int evaluate(const std::string &expr) const;
+    int evaluate(const char *expr, size_t len, int *stack,
+                 size_t capacity) const;
+    const char *tryEvaluate(const char *expr, size_t len, int *stack,
+                            size_t capacity, int &result) const;
+    std::string evaluate(const std::string &expr, Arithmetic mode) const;
+
+    // Parse once with compile(), then evaluate as often as needed
+    Program compile(const std::string &expr) const;
+    int evaluate(const Program &program, Bindings &bindings) const;
+    void evaluateColumns(const Program &program, const int *const *columns,
+                         size_t rows, int *results,
+                         unsigned char *failed) const;
+    // Native code for a compiled program; evaluate() falls back to the
+    // interpreter when it is unavailable or a division by zero needs to throw
+    Jit jit(const Program &program) const;
+    int evaluate(const Jit &jit, Bindings &bindings) const;
 
   private:
-    bool isOperator(const std::string &token) const;
-    int applyOperation(int a, int b, const std::string &op) const;
+    int applyOperation(int a, int b, char op) const;
 };
 #endif
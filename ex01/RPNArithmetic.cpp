@@ -0,0 +1,151 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RPNArithmetic.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:54:29 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 02:29:45 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "RPN.hpp"
+#include "RPNBigInt.hpp"
+#include "RPNRational.hpp"
+#include <cctype>
+#include <limits>
+#include <stdexcept>
+#include <stdint.h>
+#include <vector>
+
+static const int64_t g_max = std::numeric_limits<int64_t>::max();
+static const int64_t g_min = std::numeric_limits<int64_t>::min();
+
+static bool isSpace(char c) {
+  return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+// int64_t whose operations throw "overflow" instead of wrapping
+class CheckedInt64 {
+public:
+  CheckedInt64() : value(0) {}
+  explicit CheckedInt64(int64_t value) : value(value) {}
+
+  CheckedInt64 operator+(const CheckedInt64 &other) const {
+    if ((other.value > 0 && value > g_max - other.value) ||
+        (other.value < 0 && value < g_min - other.value))
+      throw std::runtime_error("overflow");
+    return CheckedInt64(value + other.value);
+  }
+
+  CheckedInt64 operator-(const CheckedInt64 &other) const {
+    if ((other.value < 0 && value > g_max + other.value) ||
+        (other.value > 0 && value < g_min + other.value))
+      throw std::runtime_error("overflow");
+    return CheckedInt64(value - other.value);
+  }
+
+  CheckedInt64 operator*(const CheckedInt64 &other) const {
+    int64_t a;
+    int64_t b;
+
+    a = value;
+    b = other.value;
+    if (a == 0 || b == 0)
+      return CheckedInt64(0);
+    // Bound a by the limit the product's sign runs into; dividing by a
+    // negative b flips the inequality, and truncation keeps it exact
+    if (a > 0 ? (b > 0 ? a > g_max / b : b < g_min / a)
+              : (b > 0 ? a < g_min / b : a < g_max / b))
+      throw std::runtime_error("overflow");
+    return CheckedInt64(a * b);
+  }
+
+  CheckedInt64 operator/(const CheckedInt64 &other) const {
+    if (other.value == 0)
+      throw std::runtime_error("division by zero");
+    if (value == g_min && other.value == -1)
+      throw std::runtime_error("overflow");
+    return CheckedInt64(value / other.value);
+  }
+
+  std::string toString() const { return RPNBigInt(value).toString(); }
+
+private:
+  int64_t value;
+};
+
+static void parseLiteral(const char *digits, size_t len, CheckedInt64 &out) {
+  int64_t value;
+
+  value = 0;
+  for (size_t i = 0; i < len; ++i) {
+    if (value > (g_max - (digits[i] - '0')) / 10)
+      throw std::runtime_error("overflow");
+    value = value * 10 + (digits[i] - '0');
+  }
+  out = CheckedInt64(value);
+}
+
+static void parseLiteral(const char *digits, size_t len, RPNBigInt &out) {
+  out = RPNBigInt::parse(digits, len);
+}
+
+static void parseLiteral(const char *digits, size_t len, RPNRational &out) {
+  out = RPNRational(RPNBigInt::parse(digits, len));
+}
+
+// The tokens of evaluate(), except that a number is any run of digits
+template <class Number> static std::string evaluateAs(const std::string &expr) {
+  std::vector<Number> stack;
+  size_t pos;
+  size_t end;
+  bool digits;
+  char op;
+
+  stack.reserve((expr.size() + 1) / 2);
+  pos = 0;
+  while (true) {
+    while (pos < expr.size() && isSpace(expr[pos]))
+      ++pos;
+    if (pos == expr.size())
+      break;
+    digits = true;
+    for (end = pos; end < expr.size() && !isSpace(expr[end]); ++end)
+      digits = digits && expr[end] >= '0' && expr[end] <= '9';
+    op = expr[pos];
+    if (digits) {
+      stack.push_back(Number());
+      parseLiteral(expr.data() + pos, end - pos, stack.back());
+    } else if (end - pos == 1 &&
+               (op == '+' || op == '-' || op == '*' || op == '/')) {
+      if (stack.size() < 2)
+        throw std::runtime_error("invalid expression");
+      Number &a = stack[stack.size() - 2];
+      const Number &b = stack.back();
+      if (op == '+')
+        a = a + b;
+      else if (op == '-')
+        a = a - b;
+      else if (op == '*')
+        a = a * b;
+      else
+        a = a / b;
+      stack.pop_back();
+    } else
+      throw std::runtime_error("invalid token");
+    pos = end;
+  }
+  if (stack.size() != 1)
+    throw std::runtime_error("invalid expression");
+  return stack[0].toString();
+}
+
+std::string RPN::evaluate(const std::string &expr, Arithmetic mode) const {
+  if (mode == CHECKED_INT64)
+    return evaluateAs<CheckedInt64>(expr);
+  if (mode == RATIONAL)
+    return evaluateAs<RPNRational>(expr);
+  return evaluateAs<RPNBigInt>(expr);
+}
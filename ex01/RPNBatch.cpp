@@ -0,0 +1,259 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RPNBatch.cpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:38:26 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:48:21 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "RPNBatch.hpp"
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <unistd.h>
+
+// Input is cut into chunks of at least this size at line boundaries
+static const size_t g_chunkSize = 1 << 20;
+// How many chunks each worker may run ahead of the writer
+static const size_t g_chunksPerWorker = 4;
+
+struct RPNBatch::Pool {
+  RPN rpn;
+  RPNCache *cache;
+  std::vector<Chunk> slots;
+  size_t nextRead;
+  size_t nextClaim;
+  size_t nextWrite;
+  bool done;
+  pthread_mutex_t lock;
+  pthread_cond_t work;
+  pthread_cond_t chunkDone;
+};
+
+RPNBatch::RPNBatch() : workers(1), cache(NULL) {}
+
+RPNBatch::RPNBatch(size_t workers, RPNCache *cache)
+    : workers(workers ? workers : 1), cache(cache) {}
+
+RPNBatch::RPNBatch(const RPNBatch &other)
+    : workers(other.workers), cache(other.cache) {}
+
+RPNBatch &RPNBatch::operator=(const RPNBatch &other) {
+  if (this != &other) {
+    workers = other.workers;
+    cache = other.cache;
+  }
+  return *this;
+}
+
+RPNBatch::~RPNBatch() {}
+
+bool RPNBatch::run(int fd) const {
+  Pool pool;
+  std::vector<pthread_t> threads(workers);
+  std::string carry;
+  size_t started;
+  bool eof;
+  bool ok;
+
+  pool.cache = cache;
+  pool.slots.resize(workers * g_chunksPerWorker);
+  for (size_t i = 0; i < pool.slots.size(); ++i)
+    pool.slots[i].ready = false;
+  pool.nextRead = 0;
+  pool.nextClaim = 0;
+  pool.nextWrite = 0;
+  pool.done = false;
+  pthread_mutex_init(&pool.lock, NULL);
+  pthread_cond_init(&pool.work, NULL);
+  pthread_cond_init(&pool.chunkDone, NULL);
+  started = 0;
+  while (started < threads.size() &&
+         pthread_create(&threads[started], NULL, runWorker, &pool) == 0)
+    ++started;
+  std::vector<int> stack;
+  eof = false;
+  ok = true;
+  while (true) {
+    // Fill every free slot, then write out the oldest chunk
+    while (!eof && pool.nextRead < pool.nextWrite + pool.slots.size()) {
+      Chunk &chunk = pool.slots[pool.nextRead % pool.slots.size()];
+      if (!readChunk(fd, carry, chunk, eof)) {
+        ok = false;
+        eof = true;
+      }
+      pthread_mutex_lock(&pool.lock);
+      if (!chunk.input.empty())
+        ++pool.nextRead;
+      pool.done = eof;
+      pthread_cond_broadcast(&pool.work);
+      pthread_mutex_unlock(&pool.lock);
+    }
+    if (pool.nextWrite == pool.nextRead)
+      break;
+    Chunk &chunk = pool.slots[pool.nextWrite % pool.slots.size()];
+    pthread_mutex_lock(&pool.lock);
+    while (!chunk.ready) {
+      if (started == 0) {
+        ++pool.nextClaim;
+        evaluateChunk(pool.rpn, pool.cache, chunk, stack);
+        chunk.ready = true;
+      } else
+        pthread_cond_wait(&pool.chunkDone, &pool.lock);
+    }
+    pthread_mutex_unlock(&pool.lock);
+    if (!writeChunk(chunk))
+      ok = false;
+    pthread_mutex_lock(&pool.lock);
+    chunk.ready = false;
+    ++pool.nextWrite;
+    pthread_mutex_unlock(&pool.lock);
+  }
+  for (size_t i = 0; i < started; ++i)
+    pthread_join(threads[i], NULL);
+  pthread_cond_destroy(&pool.chunkDone);
+  pthread_cond_destroy(&pool.work);
+  pthread_mutex_destroy(&pool.lock);
+  return ok;
+}
+
+void *RPNBatch::runWorker(void *arg) {
+  Pool *pool;
+  std::vector<int> stack;
+  size_t index;
+
+  pool = static_cast<Pool *>(arg);
+  pthread_mutex_lock(&pool->lock);
+  while (true) {
+    while (pool->nextClaim == pool->nextRead && !pool->done)
+      pthread_cond_wait(&pool->work, &pool->lock);
+    if (pool->nextClaim == pool->nextRead)
+      break;
+    index = pool->nextClaim++ % pool->slots.size();
+    pthread_mutex_unlock(&pool->lock);
+    evaluateChunk(pool->rpn, pool->cache, pool->slots[index], stack);
+    pthread_mutex_lock(&pool->lock);
+    pool->slots[index].ready = true;
+    pthread_cond_broadcast(&pool->chunkDone);
+  }
+  pthread_mutex_unlock(&pool->lock);
+  return NULL;
+}
+
+void RPNBatch::evaluateChunk(const RPN &rpn, RPNCache *cache, Chunk &chunk,
+                             std::vector<int> &stack) {
+  const char *line;
+  const char *end;
+  const char *eol;
+  const char *error;
+  char digits[16];
+  char *p;
+  unsigned int magnitude;
+  int value;
+
+  chunk.output.clear();
+  chunk.runs.clear();
+  line = chunk.input.data();
+  end = line + chunk.input.size();
+  while (line < end) {
+    eol = static_cast<const char *>(std::memchr(line, '\n', end - line));
+    if (!eol)
+      eol = end;
+    if (stack.size() < static_cast<size_t>(eol - line + 2) / 2)
+      stack.resize((eol - line + 2) / 2);
+    if (cache)
+      error = cache->tryEvaluate(rpn, line, eol - line, &stack[0],
+                                 stack.size(), value);
+    else
+      error =
+          rpn.tryEvaluate(line, eol - line, &stack[0], stack.size(), value);
+    if (error) {
+      append(chunk, STDERR_FILENO, "Error: ", 7);
+      append(chunk, STDERR_FILENO, error, std::strlen(error));
+      append(chunk, STDERR_FILENO, "\n", 1);
+    } else {
+      magnitude = value < 0 ? 0u - static_cast<unsigned int>(value)
+                            : static_cast<unsigned int>(value);
+      p = digits + sizeof(digits);
+      *--p = '\n';
+      do {
+        *--p = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+      } while (magnitude);
+      if (value < 0)
+        *--p = '-';
+      append(chunk, STDOUT_FILENO, p, digits + sizeof(digits) - p);
+    }
+    line = eol + 1;
+  }
+}
+
+void RPNBatch::append(Chunk &chunk, int fd, const char *str, size_t len) {
+  Run run;
+
+  if (chunk.runs.empty() || chunk.runs.back().fd != fd) {
+    run.fd = fd;
+    run.length = 0;
+    chunk.runs.push_back(run);
+  }
+  chunk.runs.back().length += len;
+  chunk.output.append(str, len);
+}
+
+bool RPNBatch::writeChunk(const Chunk &chunk) {
+  const char *data;
+  size_t left;
+  ssize_t n;
+
+  data = chunk.output.data();
+  for (size_t i = 0; i < chunk.runs.size(); ++i) {
+    left = chunk.runs[i].length;
+    while (left > 0) {
+      n = write(chunk.runs[i].fd, data, left);
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n <= 0)
+        return false;
+      data += n;
+      left -= n;
+    }
+  }
+  return true;
+}
+
+// The partial line carried over from the last read plus more input, up to
+// the last newline once at least g_chunkSize bytes are in; at the end of
+// the input, whatever is left
+bool RPNBatch::readChunk(int fd, std::string &carry, Chunk &chunk,
+                         bool &eof) {
+  char buffer[1 << 16];
+  const char *newline;
+  size_t lastNewline;
+  ssize_t n;
+
+  chunk.input.swap(carry);
+  carry.clear();
+  newline = static_cast<const char *>(
+      memrchr(chunk.input.data(), '\n', chunk.input.size()));
+  lastNewline = newline ? newline - chunk.input.data() : std::string::npos;
+  while (chunk.input.size() < g_chunkSize || lastNewline == std::string::npos) {
+    n = read(fd, buffer, sizeof(buffer));
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0) {
+      eof = true;
+      return n == 0;
+    }
+    newline = static_cast<const char *>(memrchr(buffer, '\n', n));
+    if (newline)
+      lastNewline = chunk.input.size() + (newline - buffer);
+    chunk.input.append(buffer, n);
+  }
+  carry.assign(chunk.input, lastNewline + 1, std::string::npos);
+  chunk.input.resize(lastNewline + 1);
+  return true;
+}
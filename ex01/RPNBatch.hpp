@@ -0,0 +1,64 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RPNBatch.hpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:37:53 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:48:21 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RPN_BATCH__HPP
+#define RPN_BATCH__HPP
+#include "RPN.hpp"
+#include "RPNCache.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Evaluates a stream of newline-separated expressions on a pool of
+// threads. Input is read in chunks of about a megabyte cut at line
+// boundaries; workers take chunks in order, and at most a few chunks per
+// worker are in flight, so memory stays bounded however long the input
+// is. Results go to stdout and errors to stderr in input order. With a
+// cache, repeated expressions are answered from it.
+class RPNBatch {
+  public:
+    RPNBatch();
+    explicit RPNBatch(size_t workers, RPNCache *cache = NULL);
+    RPNBatch(const RPNBatch &other);
+    RPNBatch &operator=(const RPNBatch &other);
+    ~RPNBatch();
+
+    // Returns false when reading fd fails
+    bool run(int fd) const;
+
+  private:
+    struct Run {
+        int fd;
+        size_t length;
+    };
+
+    struct Chunk {
+        std::string input;
+        std::string output;
+        std::vector<Run> runs;
+        bool ready;
+    };
+
+    struct Pool;
+
+    size_t workers;
+    RPNCache *cache;
+
+    static void *runWorker(void *arg);
+    static void evaluateChunk(const RPN &rpn, RPNCache *cache, Chunk &chunk,
+                              std::vector<int> &stack);
+    static void append(Chunk &chunk, int fd, const char *str, size_t len);
+    static bool writeChunk(const Chunk &chunk);
+    static bool readChunk(int fd, std::string &carry, Chunk &chunk,
+                          bool &eof);
+};
+#endif
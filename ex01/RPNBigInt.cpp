@@ -0,0 +1,441 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RPNBigInt.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:53:17 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:57:59 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "RPNBigInt.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+typedef std::vector<uint32_t> Limbs;
+
+static const uint32_t g_base = 1000000000;
+static const size_t g_baseDigits = 9;
+// Below this many limbs in the shorter operand, schoolbook multiplication
+// beats the bookkeeping of Karatsuba
+static const size_t g_karatsubaLimbs = 32;
+
+static void trim(Limbs &a) {
+  while (!a.empty() && a.back() == 0)
+    a.pop_back();
+}
+
+static int compareMagnitude(const Limbs &a, const Limbs &b) {
+  if (a.size() != b.size())
+    return a.size() < b.size() ? -1 : 1;
+  for (size_t i = a.size(); i-- > 0;) {
+    if (a[i] != b[i])
+      return a[i] < b[i] ? -1 : 1;
+  }
+  return 0;
+}
+
+// a += b << (shift limbs)
+static void addShifted(Limbs &a, const Limbs &b, size_t shift) {
+  uint32_t carry;
+  uint32_t sum;
+
+  if (a.size() < b.size() + shift)
+    a.resize(b.size() + shift, 0);
+  carry = 0;
+  for (size_t i = 0; i < b.size() || carry; ++i) {
+    if (i + shift == a.size())
+      a.push_back(0);
+    sum = a[i + shift] + carry + (i < b.size() ? b[i] : 0);
+    carry = sum >= g_base;
+    a[i + shift] = carry ? sum - g_base : sum;
+  }
+}
+
+// a -= b, where a >= b
+static void subtract(Limbs &a, const Limbs &b) {
+  uint32_t borrow;
+  uint32_t take;
+
+  borrow = 0;
+  for (size_t i = 0; i < b.size() || borrow; ++i) {
+    take = (i < b.size() ? b[i] : 0) + borrow;
+    borrow = a[i] < take;
+    a[i] = borrow ? a[i] + g_base - take : a[i] - take;
+  }
+  trim(a);
+}
+
+static void multiplySchoolbook(const uint32_t *a, size_t na, const uint32_t *b,
+                               size_t nb, Limbs &out) {
+  uint64_t carry;
+  uint64_t cell;
+
+  out.assign(na + nb, 0);
+  for (size_t i = 0; i < na; ++i) {
+    carry = 0;
+    for (size_t j = 0; j < nb; ++j) {
+      cell = out[i + j] + static_cast<uint64_t>(a[i]) * b[j] + carry;
+      carry = cell / g_base;
+      out[i + j] = static_cast<uint32_t>(cell % g_base);
+    }
+    out[i + nb] = static_cast<uint32_t>(carry);
+  }
+  trim(out);
+}
+
+static void multiply(const uint32_t *a, size_t na, const uint32_t *b,
+                     size_t nb, Limbs &out);
+
+// Both halves split at the same limb, so that
+// a * b = hi * B^2m + ((a0 + a1)(b0 + b1) - hi - lo) * B^m + lo
+static void multiplyKaratsuba(const uint32_t *a, size_t na, const uint32_t *b,
+                              size_t nb, Limbs &out) {
+  size_t m;
+  Limbs low;
+  Limbs high;
+  Limbs sumA;
+  Limbs sumB;
+  Limbs middle;
+
+  m = std::max(na, nb) / 2;
+  multiply(a, std::min(na, m), b, std::min(nb, m), low);
+  multiply(a + m, na - m, b + m, nb - m, high);
+  sumA.assign(a, a + std::min(na, m));
+  trim(sumA);
+  addShifted(sumA, Limbs(a + m, a + na), 0);
+  sumB.assign(b, b + std::min(nb, m));
+  trim(sumB);
+  addShifted(sumB, Limbs(b + m, b + nb), 0);
+  multiply(sumA.empty() ? NULL : &sumA[0], sumA.size(),
+           sumB.empty() ? NULL : &sumB[0], sumB.size(), middle);
+  subtract(middle, low);
+  subtract(middle, high);
+  out = low;
+  addShifted(out, middle, m);
+  addShifted(out, high, 2 * m);
+  trim(out);
+}
+
+// An operand much longer than the other is cut into pieces of the
+// shorter one's size, so each product is balanced
+static void multiply(const uint32_t *a, size_t na, const uint32_t *b,
+                     size_t nb, Limbs &out) {
+  Limbs piece;
+
+  while (na > 0 && a[na - 1] == 0)
+    --na;
+  while (nb > 0 && b[nb - 1] == 0)
+    --nb;
+  if (na < nb) {
+    std::swap(a, b);
+    std::swap(na, nb);
+  }
+  if (nb == 0) {
+    out.clear();
+    return;
+  }
+  if (nb < g_karatsubaLimbs) {
+    multiplySchoolbook(a, na, b, nb, out);
+    return;
+  }
+  if (na < 2 * nb) {
+    multiplyKaratsuba(a, na, b, nb, out);
+    return;
+  }
+  out.clear();
+  for (size_t at = 0; at < na; at += nb) {
+    multiply(a + at, std::min(nb, na - at), b, nb, piece);
+    addShifted(out, piece, at);
+  }
+  trim(out);
+}
+
+// a /= d, returning the remainder
+static uint32_t divideSmall(Limbs &a, uint32_t d) {
+  uint64_t rest;
+
+  rest = 0;
+  for (size_t i = a.size(); i-- > 0;) {
+    rest = rest * g_base + a[i];
+    a[i] = static_cast<uint32_t>(rest / d);
+    rest %= d;
+  }
+  trim(a);
+  return static_cast<uint32_t>(rest);
+}
+
+static void multiplySmall(Limbs &a, uint32_t m) {
+  uint64_t carry;
+  uint64_t cell;
+
+  carry = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    cell = static_cast<uint64_t>(a[i]) * m + carry;
+    a[i] = static_cast<uint32_t>(cell % g_base);
+    carry = cell / g_base;
+  }
+  if (carry)
+    a.push_back(static_cast<uint32_t>(carry));
+  trim(a);
+}
+
+// Long division (Knuth's algorithm D) in base 10^9: the divisor is scaled
+// so its top limb is at least half the base, which keeps each estimated
+// quotient limb at most two too large
+static void divideMagnitude(const Limbs &u, const Limbs &v, Limbs &q,
+                            Limbs &r) {
+  Limbs un;
+  Limbs vn;
+  uint32_t scale;
+  size_t n;
+  uint64_t top;
+  uint64_t qhat;
+  uint64_t rhat;
+  uint64_t product;
+  uint64_t carry;
+  int64_t cell;
+  int64_t borrow;
+
+  if (compareMagnitude(u, v) < 0) {
+    q.clear();
+    r = u;
+    return;
+  }
+  if (v.size() == 1) {
+    q = u;
+    r.assign(1, divideSmall(q, v[0]));
+    trim(r);
+    return;
+  }
+  scale = g_base / (v.back() + 1);
+  un = u;
+  vn = v;
+  multiplySmall(un, scale);
+  multiplySmall(vn, scale);
+  un.resize(u.size() + 1, 0);
+  n = vn.size();
+  q.assign(un.size() - n, 0);
+  for (size_t j = un.size() - n; j-- > 0;) {
+    top = static_cast<uint64_t>(un[j + n]) * g_base + un[j + n - 1];
+    qhat = top / vn[n - 1];
+    rhat = top % vn[n - 1];
+    while (qhat >= g_base ||
+           qhat * vn[n - 2] > rhat * g_base + un[j + n - 2]) {
+      --qhat;
+      rhat += vn[n - 1];
+      if (rhat >= g_base)
+        break;
+    }
+    borrow = 0;
+    carry = 0;
+    for (size_t i = 0; i < n; ++i) {
+      product = qhat * vn[i] + carry;
+      carry = product / g_base;
+      cell = static_cast<int64_t>(un[i + j]) -
+             static_cast<int64_t>(product % g_base) - borrow;
+      borrow = cell < 0;
+      un[i + j] = static_cast<uint32_t>(cell < 0 ? cell + g_base : cell);
+    }
+    cell = static_cast<int64_t>(un[j + n]) - static_cast<int64_t>(carry) -
+           borrow;
+    if (cell < 0) {
+      // qhat was one too large: add the divisor back
+      --qhat;
+      carry = 0;
+      for (size_t i = 0; i < n; ++i) {
+        product = static_cast<uint64_t>(un[i + j]) + vn[i] + carry;
+        carry = product >= g_base;
+        un[i + j] = static_cast<uint32_t>(product - carry * g_base);
+      }
+      cell += g_base + static_cast<int64_t>(carry);
+    }
+    un[j + n] = static_cast<uint32_t>(cell % g_base);
+    q[j] = static_cast<uint32_t>(qhat);
+  }
+  trim(q);
+  un.resize(n);
+  trim(un);
+  divideSmall(un, scale);
+  r = un;
+}
+
+RPNBigInt::RPNBigInt() : negative(false) {}
+
+RPNBigInt::RPNBigInt(int64_t value) : negative(value < 0) {
+  uint64_t magnitude;
+
+  magnitude = value < 0 ? 0 - static_cast<uint64_t>(value)
+                        : static_cast<uint64_t>(value);
+  while (magnitude) {
+    limbs.push_back(static_cast<uint32_t>(magnitude % g_base));
+    magnitude /= g_base;
+  }
+}
+
+RPNBigInt::RPNBigInt(const RPNBigInt &other)
+    : limbs(other.limbs), negative(other.negative) {}
+
+RPNBigInt &RPNBigInt::operator=(const RPNBigInt &other) {
+  if (this != &other) {
+    limbs = other.limbs;
+    negative = other.negative;
+  }
+  return *this;
+}
+
+RPNBigInt::~RPNBigInt() {}
+
+RPNBigInt RPNBigInt::parse(const char *digits, size_t len) {
+  RPNBigInt result;
+  uint32_t limb;
+  size_t start;
+
+  result.limbs.reserve(len / g_baseDigits + 1);
+  for (size_t end = len; end > 0; end = start) {
+    start = end > g_baseDigits ? end - g_baseDigits : 0;
+    limb = 0;
+    for (size_t i = start; i < end; ++i)
+      limb = limb * 10 + (digits[i] - '0');
+    result.limbs.push_back(limb);
+  }
+  trim(result.limbs);
+  return result;
+}
+
+RPNBigInt RPNBigInt::add(const RPNBigInt &a, const RPNBigInt &b,
+                         bool negateB) {
+  RPNBigInt result;
+  bool bNegative;
+
+  bNegative = b.negative != negateB;
+  if (a.negative == bNegative) {
+    result.limbs = a.limbs;
+    addShifted(result.limbs, b.limbs, 0);
+    result.negative = a.negative;
+  } else if (compareMagnitude(a.limbs, b.limbs) >= 0) {
+    result.limbs = a.limbs;
+    subtract(result.limbs, b.limbs);
+    result.negative = a.negative;
+  } else {
+    result.limbs = b.limbs;
+    subtract(result.limbs, a.limbs);
+    result.negative = bNegative;
+  }
+  if (result.limbs.empty())
+    result.negative = false;
+  return result;
+}
+
+RPNBigInt RPNBigInt::operator+(const RPNBigInt &other) const {
+  return add(*this, other, false);
+}
+
+RPNBigInt RPNBigInt::operator-(const RPNBigInt &other) const {
+  return add(*this, other, true);
+}
+
+RPNBigInt RPNBigInt::operator*(const RPNBigInt &other) const {
+  RPNBigInt result;
+
+  multiply(limbs.empty() ? NULL : &limbs[0], limbs.size(),
+           other.limbs.empty() ? NULL : &other.limbs[0], other.limbs.size(),
+           result.limbs);
+  result.negative = !result.limbs.empty() && negative != other.negative;
+  return result;
+}
+
+// The remainder takes the sign of the dividend, as with int
+void RPNBigInt::divide(const RPNBigInt &a, const RPNBigInt &b,
+                       RPNBigInt &quotient, RPNBigInt &remainder) {
+  Limbs q;
+  Limbs r;
+
+  if (b.limbs.empty())
+    throw std::runtime_error("division by zero");
+  divideMagnitude(a.limbs, b.limbs, q, r);
+  quotient.limbs.swap(q);
+  quotient.negative = !quotient.limbs.empty() && a.negative != b.negative;
+  remainder.limbs.swap(r);
+  remainder.negative = !remainder.limbs.empty() && a.negative;
+}
+
+RPNBigInt RPNBigInt::operator/(const RPNBigInt &other) const {
+  RPNBigInt quotient;
+  RPNBigInt remainder;
+
+  divide(*this, other, quotient, remainder);
+  return quotient;
+}
+
+RPNBigInt RPNBigInt::operator%(const RPNBigInt &other) const {
+  RPNBigInt quotient;
+  RPNBigInt remainder;
+
+  divide(*this, other, quotient, remainder);
+  return remainder;
+}
+
+RPNBigInt RPNBigInt::operator-() const {
+  RPNBigInt result(*this);
+
+  result.negative = !limbs.empty() && !negative;
+  return result;
+}
+
+int RPNBigInt::compare(const RPNBigInt &other) const {
+  int magnitude;
+
+  if (negative != other.negative)
+    return negative ? -1 : 1;
+  magnitude = compareMagnitude(limbs, other.limbs);
+  return negative ? -magnitude : magnitude;
+}
+
+bool RPNBigInt::isZero() const { return limbs.empty(); }
+
+bool RPNBigInt::isNegative() const { return negative; }
+
+std::string RPNBigInt::toString() const {
+  std::string result;
+  char digits[g_baseDigits];
+  uint32_t limb;
+  size_t skip;
+
+  if (limbs.empty())
+    return "0";
+  result.reserve(limbs.size() * g_baseDigits + 1);
+  if (negative)
+    result += '-';
+  for (size_t i = limbs.size(); i-- > 0;) {
+    limb = limbs[i];
+    for (size_t d = g_baseDigits; d-- > 0;) {
+      digits[d] = static_cast<char>('0' + limb % 10);
+      limb /= 10;
+    }
+    // No leading zeros in the top limb
+    skip = 0;
+    while (i + 1 == limbs.size() && skip + 1 < g_baseDigits &&
+           digits[skip] == '0')
+      ++skip;
+    result.append(digits + skip, g_baseDigits - skip);
+  }
+  return result;
+}
+
+// Always nonnegative; gcd(0, 0) is 0
+RPNBigInt RPNBigInt::gcd(RPNBigInt a, RPNBigInt b) {
+  RPNBigInt quotient;
+  RPNBigInt remainder;
+
+  a.negative = false;
+  b.negative = false;
+  while (!b.isZero()) {
+    divide(a, b, quotient, remainder);
+    a.limbs.swap(b.limbs);
+    b.limbs.swap(remainder.limbs);
+  }
+  return a;
+}
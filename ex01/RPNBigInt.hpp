@@ -0,0 +1,61 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RPNBigInt.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:53:17 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:57:59 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RPN_BIG_INT__HPP
+#define RPN_BIG_INT__HPP
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// A signed integer of any size, as limbs of nine decimal digits each,
+// least significant first, so reading and printing decimal are linear.
+// Products of large operands use Karatsuba multiplication.
+class RPNBigInt {
+  public:
+    RPNBigInt();
+    RPNBigInt(int64_t value);
+    RPNBigInt(const RPNBigInt &other);
+    RPNBigInt &operator=(const RPNBigInt &other);
+    ~RPNBigInt();
+
+    // From a nonempty run of decimal digits
+    static RPNBigInt parse(const char *digits, size_t len);
+
+    RPNBigInt operator+(const RPNBigInt &other) const;
+    RPNBigInt operator-(const RPNBigInt &other) const;
+    RPNBigInt operator*(const RPNBigInt &other) const;
+    // Truncates toward zero like int division; throws "division by zero"
+    RPNBigInt operator/(const RPNBigInt &other) const;
+    RPNBigInt operator%(const RPNBigInt &other) const;
+    RPNBigInt operator-() const;
+
+    int compare(const RPNBigInt &other) const;
+    bool isZero() const;
+    bool isNegative() const;
+    std::string toString() const;
+
+    static RPNBigInt gcd(RPNBigInt a, RPNBigInt b);
+    static void divide(const RPNBigInt &a, const RPNBigInt &b,
+                       RPNBigInt &quotient, RPNBigInt &remainder);
+
+  private:
+    typedef std::vector<uint32_t> Limbs;
+
+    Limbs limbs;
+    // Never set on zero, which has no limbs
+    bool negative;
+
+    static RPNBigInt add(const RPNBigInt &a, const RPNBigInt &b,
+                         bool negateB);
+};
+#endif
@@ -0,0 +1,219 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RPNCache.cpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:45:40 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:48:21 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "RPNCache.hpp"
+#include <cstring>
+
+static const size_t g_shards = 16;
+static const size_t g_ways = 8;
+static const size_t g_defaultCapacity = 4096;
+
+// std::isspace() in the "C" locale, without the library call per byte
+static bool isSpace(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+// FNV-1a over the tokens joined by single spaces; keyLen gets the length
+// of that joined form. Digits and operators differ little in their low
+// bits, so the result is mixed before its low bits pick a shard and set.
+static unsigned long long hashTokens(const char *expr, size_t len,
+                                     size_t &keyLen) {
+  unsigned long long hash;
+  bool separate;
+
+  hash = 14695981039346656037ull;
+  keyLen = 0;
+  separate = false;
+  for (size_t i = 0; i < len; ++i) {
+    if (isSpace(expr[i])) {
+      separate = keyLen > 0;
+      continue;
+    }
+    if (separate) {
+      hash = (hash ^ ' ') * 1099511628211ull;
+      ++keyLen;
+      separate = false;
+    }
+    hash = (hash ^ static_cast<unsigned char>(expr[i])) * 1099511628211ull;
+    ++keyLen;
+  }
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdull;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// A line already in joined form (the usual case) compares with memcmp
+static bool sameTokens(const std::string &key, const char *expr, size_t len) {
+  size_t k;
+  bool separate;
+
+  if (key.size() == len && std::memcmp(key.data(), expr, len) == 0)
+    return true;
+  k = 0;
+  separate = false;
+  for (size_t i = 0; i < len; ++i) {
+    if (isSpace(expr[i])) {
+      separate = k > 0;
+      continue;
+    }
+    if (separate) {
+      if (k == key.size() || key[k++] != ' ')
+        return false;
+      separate = false;
+    }
+    if (k == key.size() || key[k++] != expr[i])
+      return false;
+  }
+  return k == key.size();
+}
+
+static void joinTokens(const char *expr, size_t len, std::string &key) {
+  bool separate;
+
+  key.clear();
+  separate = false;
+  for (size_t i = 0; i < len; ++i) {
+    if (isSpace(expr[i])) {
+      separate = !key.empty();
+      continue;
+    }
+    if (separate)
+      key += ' ';
+    separate = false;
+    key += expr[i];
+  }
+}
+
+RPNCache::RPNCache() : shards(NULL), sets(0) { allocate(g_defaultCapacity); }
+
+RPNCache::RPNCache(size_t capacity) : shards(NULL), sets(0) {
+  allocate(capacity);
+}
+
+// Copies the size, not the entries or the counters
+RPNCache::RPNCache(const RPNCache &other) : shards(NULL), sets(0) {
+  allocate(other.capacity());
+}
+
+RPNCache &RPNCache::operator=(const RPNCache &other) {
+  if (this != &other) {
+    release();
+    allocate(other.capacity());
+  }
+  return *this;
+}
+
+RPNCache::~RPNCache() { release(); }
+
+void RPNCache::allocate(size_t capacity) {
+  sets = (capacity + g_shards * g_ways - 1) / (g_shards * g_ways);
+  if (sets == 0)
+    sets = 1;
+  shards = new Shard[g_shards];
+  for (size_t i = 0; i < g_shards; ++i) {
+    pthread_mutex_init(&shards[i].lock, NULL);
+    shards[i].entries = new Entry[sets * g_ways];
+    for (size_t j = 0; j < sets * g_ways; ++j)
+      shards[i].entries[j].stamp = 0;
+    shards[i].clock = 0;
+    shards[i].hits = 0;
+    shards[i].misses = 0;
+    shards[i].evictions = 0;
+  }
+}
+
+void RPNCache::release() {
+  if (!shards)
+    return;
+  for (size_t i = 0; i < g_shards; ++i) {
+    pthread_mutex_destroy(&shards[i].lock);
+    delete[] shards[i].entries;
+  }
+  delete[] shards;
+  shards = NULL;
+}
+
+const char *RPNCache::tryEvaluate(const RPN &rpn, const char *expr,
+                                  size_t len, int *stack, size_t capacity,
+                                  int &result) {
+  unsigned long long hash;
+  size_t keyLen;
+  Shard *shard;
+  Entry *set;
+  Entry *victim;
+  const char *error;
+
+  hash = hashTokens(expr, len, keyLen);
+  // Tokens are one byte apart in the joined form, so a stack this big
+  // never overflows and every cached answer holds for any caller
+  if (keyLen > maxKey || capacity < (keyLen + 1) / 2)
+    return rpn.tryEvaluate(expr, len, stack, capacity, result);
+  // Low bits pick the shard, the next ones the set; stamp 0 marks a free
+  // entry
+  shard = &shards[hash % g_shards];
+  set = shard->entries + (hash / g_shards) % sets * g_ways;
+  pthread_mutex_lock(&shard->lock);
+  for (size_t i = 0; i < g_ways; ++i) {
+    if (set[i].stamp && set[i].hash == hash &&
+        sameTokens(set[i].key, expr, len)) {
+      set[i].stamp = ++shard->clock;
+      ++shard->hits;
+      error = set[i].error;
+      result = set[i].result;
+      pthread_mutex_unlock(&shard->lock);
+      return error;
+    }
+  }
+  ++shard->misses;
+  pthread_mutex_unlock(&shard->lock);
+  error = rpn.tryEvaluate(expr, len, stack, capacity, result);
+  pthread_mutex_lock(&shard->lock);
+  victim = set;
+  for (size_t i = 0; i < g_ways; ++i) {
+    if (set[i].stamp && set[i].hash == hash &&
+        sameTokens(set[i].key, expr, len)) {
+      victim = &set[i];
+      break;
+    }
+    if (set[i].stamp < victim->stamp)
+      victim = &set[i];
+  }
+  if (victim->stamp && !(victim->hash == hash &&
+                         sameTokens(victim->key, expr, len)))
+    ++shard->evictions;
+  joinTokens(expr, len, victim->key);
+  victim->hash = hash;
+  victim->stamp = ++shard->clock;
+  victim->error = error;
+  victim->result = error ? 0 : result;
+  pthread_mutex_unlock(&shard->lock);
+  return error;
+}
+
+size_t RPNCache::capacity() const { return g_shards * sets * g_ways; }
+
+unsigned long RPNCache::sum(unsigned long Shard::*counter) const {
+  unsigned long total;
+
+  total = 0;
+  for (size_t i = 0; i < g_shards; ++i) {
+    pthread_mutex_lock(&shards[i].lock);
+    total += shards[i].*counter;
+    pthread_mutex_unlock(&shards[i].lock);
+  }
+  return total;
+}
+
+unsigned long RPNCache::hits() const { return sum(&Shard::hits); }
+
+unsigned long RPNCache::misses() const { return sum(&Shard::misses); }
+
+unsigned long RPNCache::evictions() const { return sum(&Shard::evictions); }
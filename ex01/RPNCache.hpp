@@ -0,0 +1,71 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RPNCache.hpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:45:39 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:48:21 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RPN_CACHE__HPP
+#define RPN_CACHE__HPP
+#include "RPN.hpp"
+#include <cstddef>
+#include <pthread.h>
+#include <string>
+
+// A bounded map from expression text to what RPN::tryEvaluate() returned
+// for it, safe to share between threads. Entries are keyed by a hash of
+// the token stream, so spacing does not matter, and the tokens themselves
+// are kept to rule out collisions. The table is split into shards with a
+// lock each; within a shard a key can go in one of eight entries, and the
+// least recently used of them is evicted when all eight are taken.
+class RPNCache {
+  public:
+    RPNCache();
+    explicit RPNCache(size_t capacity);
+    RPNCache(const RPNCache &other);
+    RPNCache &operator=(const RPNCache &other);
+    ~RPNCache();
+
+    // Same as rpn.tryEvaluate(); expressions longer than maxKey bytes of
+    // tokens, or with a stack that might be too small, skip the cache
+    const char *tryEvaluate(const RPN &rpn, const char *expr, size_t len,
+                            int *stack, size_t capacity, int &result);
+
+    size_t capacity() const;
+    unsigned long hits() const;
+    unsigned long misses() const;
+    unsigned long evictions() const;
+
+    static const size_t maxKey = 256;
+
+  private:
+    struct Entry {
+        std::string key;
+        unsigned long long hash;
+        unsigned long stamp;
+        const char *error;
+        int result;
+    };
+
+    struct Shard {
+        pthread_mutex_t lock;
+        Entry *entries;
+        unsigned long clock;
+        unsigned long hits;
+        unsigned long misses;
+        unsigned long evictions;
+    };
+
+    Shard *shards;
+    size_t sets;
+
+    void allocate(size_t capacity);
+    void release();
+    unsigned long sum(unsigned long Shard::*counter) const;
+};
+#endif
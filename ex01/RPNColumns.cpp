@@ -0,0 +1,223 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RPNColumns.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:40:55 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:42:42 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "RPN.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define RPN_HAVE_AVX2 1
+#endif
+
+// Rows evaluated per pass over the bytecode; the scratch columns for one
+// block of every stack depth stay in cache
+static const size_t g_block = 1024;
+
+typedef void (*Kernel)(unsigned char op, int *dst, const int *a,
+                       const int *b, unsigned char *failed, size_t n);
+
+// dst[i] = a[i] op b[i]. A zero divisor marks the row as failed, and
+// INT_MIN / -1 wraps to INT_MIN as the vector paths do instead of
+// trapping.
+static void applyScalar(unsigned char op, int *dst, const int *a,
+                        const int *b, unsigned char *failed, size_t n) {
+  size_t i;
+
+  switch (op) {
+  case RPNProgram::ADD:
+    for (i = 0; i < n; ++i)
+      dst[i] = static_cast<int>(static_cast<unsigned int>(a[i]) +
+                                static_cast<unsigned int>(b[i]));
+    break;
+  case RPNProgram::SUB:
+    for (i = 0; i < n; ++i)
+      dst[i] = static_cast<int>(static_cast<unsigned int>(a[i]) -
+                                static_cast<unsigned int>(b[i]));
+    break;
+  case RPNProgram::MUL:
+    for (i = 0; i < n; ++i)
+      dst[i] = static_cast<int>(static_cast<unsigned int>(a[i]) *
+                                static_cast<unsigned int>(b[i]));
+    break;
+  default:
+    for (i = 0; i < n; ++i) {
+      if (b[i] == 0) {
+        failed[i] = 1;
+        dst[i] = 0;
+      } else if (b[i] == -1)
+        dst[i] = static_cast<int>(0u - static_cast<unsigned int>(a[i]));
+      else
+        dst[i] = a[i] / b[i];
+    }
+  }
+}
+
+#ifdef __SSE2__
+// pmulld is SSE4.1; build it from two pmuludq
+static __m128i mulSse2(__m128i a, __m128i b) {
+  __m128i even;
+  __m128i odd;
+
+  even = _mm_mul_epu32(a, b);
+  odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// There is no integer division in SSE; an int32 quotient computed in
+// double and truncated is exact
+static __m128i divSse2(__m128i a, __m128i b) {
+  __m128i low;
+  __m128i high;
+
+  low = _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(a), _mm_cvtepi32_pd(b)));
+  a = _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2));
+  b = _mm_shuffle_epi32(b, _MM_SHUFFLE(1, 0, 3, 2));
+  high = _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(a), _mm_cvtepi32_pd(b)));
+  return _mm_unpacklo_epi64(low, high);
+}
+
+static void applySse2(unsigned char op, int *dst, const int *a, const int *b,
+                      unsigned char *failed, size_t n) {
+  __m128i x;
+  __m128i y;
+  __m128i zeros;
+  int mask;
+  size_t i;
+
+  for (i = 0; i + 4 <= n; i += 4) {
+    x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+    y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+    if (op == RPNProgram::ADD)
+      x = _mm_add_epi32(x, y);
+    else if (op == RPNProgram::SUB)
+      x = _mm_sub_epi32(x, y);
+    else if (op == RPNProgram::MUL)
+      x = mulSse2(x, y);
+    else {
+      // Divide the failed lanes by one and zero them afterwards
+      zeros = _mm_cmpeq_epi32(y, _mm_setzero_si128());
+      mask = _mm_movemask_ps(_mm_castsi128_ps(zeros));
+      y = _mm_or_si128(y, _mm_srli_epi32(zeros, 31));
+      x = _mm_andnot_si128(zeros, divSse2(x, y));
+      for (int lane = 0; mask; ++lane, mask >>= 1)
+        failed[i + lane] |= mask & 1;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), x);
+  }
+  applyScalar(op, dst + i, a + i, b + i, failed + i, n - i);
+}
+#endif
+
+#ifdef RPN_HAVE_AVX2
+__attribute__((target("avx2"))) static void
+applyAvx2(unsigned char op, int *dst, const int *a, const int *b,
+          unsigned char *failed, size_t n) {
+  __m256i x;
+  __m256i y;
+  __m256i zeros;
+  __m256d low;
+  __m256d high;
+  int mask;
+  size_t i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+    y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+    if (op == RPNProgram::ADD)
+      x = _mm256_add_epi32(x, y);
+    else if (op == RPNProgram::SUB)
+      x = _mm256_sub_epi32(x, y);
+    else if (op == RPNProgram::MUL)
+      x = _mm256_mullo_epi32(x, y);
+    else {
+      zeros = _mm256_cmpeq_epi32(y, _mm256_setzero_si256());
+      mask = _mm256_movemask_ps(_mm256_castsi256_ps(zeros));
+      y = _mm256_or_si256(y, _mm256_srli_epi32(zeros, 31));
+      low = _mm256_div_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(x)),
+                          _mm256_cvtepi32_pd(_mm256_castsi256_si128(y)));
+      high = _mm256_div_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(x, 1)),
+                           _mm256_cvtepi32_pd(_mm256_extracti128_si256(y, 1)));
+      x = _mm256_andnot_si256(
+          zeros, _mm256_inserti128_si256(
+                     _mm256_castsi128_si256(_mm256_cvttpd_epi32(low)),
+                     _mm256_cvttpd_epi32(high), 1));
+      for (int lane = 0; mask; ++lane, mask >>= 1)
+        failed[i + lane] |= mask & 1;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), x);
+  }
+  applyScalar(op, dst + i, a + i, b + i, failed + i, n - i);
+}
+#endif
+
+static Kernel pickKernel() {
+#ifdef RPN_HAVE_AVX2
+  if (__builtin_cpu_supports("avx2"))
+    return applyAvx2;
+#endif
+#ifdef __SSE2__
+  return applySse2;
+#else
+  return applyScalar;
+#endif
+}
+
+// Runs program once per row, taking variable slot k from columns[k][row].
+// Rows where evaluate() would throw "division by zero" get result 0 and
+// failed[row] = 1; every other row gets failed[row] = 0. failed may be
+// NULL, in which case such a row throws.
+void RPN::evaluateColumns(const Program &program, const int *const *columns,
+                          size_t rows, int *results,
+                          unsigned char *failed) const {
+  static const Kernel kernel = pickKernel();
+  const Program::Instruction *code;
+  std::vector<int> scratch(program.maxDepth() * g_block);
+  std::vector<const int *> stack(program.maxDepth());
+  std::vector<unsigned char> blockFailed(g_block);
+  unsigned int depth;
+  size_t n;
+
+  if (program.size() == 0)
+    throw std::runtime_error("invalid expression");
+  code = program.code();
+  for (size_t row = 0; row < rows; row += n) {
+    n = rows - row < g_block ? rows - row : g_block;
+    std::memset(&blockFailed[0], 0, n);
+    for (size_t i = 0; i < program.size(); ++i) {
+      depth = code[i].depth;
+      if (code[i].opcode == Program::PUSH) {
+        std::fill(&scratch[depth * g_block], &scratch[depth * g_block] + n,
+                  code[i].operand);
+        stack[depth] = &scratch[depth * g_block];
+      } else if (code[i].opcode == Program::LOAD)
+        stack[depth] = columns[code[i].operand] + row;
+      else {
+        kernel(code[i].opcode, &scratch[(depth - 2) * g_block],
+               stack[depth - 2], stack[depth - 1], &blockFailed[0], n);
+        stack[depth - 2] = &scratch[(depth - 2) * g_block];
+      }
+    }
+    for (size_t i = 0; i < n; ++i) {
+      if (blockFailed[i] && !failed)
+        throw std::runtime_error("division by zero");
+      results[row + i] = blockFailed[i] ? 0 : stack[0][i];
+    }
+    if (failed)
+      std::memcpy(failed + row, &blockFailed[0], n);
+  }
+}
@@ -0,0 +1,287 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RPNJit.cpp                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:43:40 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:43:40 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "RPNJit.hpp"
+#if defined(__x86_64__) && defined(__unix__)
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+#define RPN_HAVE_JIT 1
+#endif
+
+RPNJit::RPNJit() : page(NULL), pageSize(0), entry(NULL) {}
+
+RPNJit::RPNJit(const RPNProgram &program)
+    : source(program), page(NULL), pageSize(0), entry(NULL) {
+  build();
+}
+
+RPNJit::RPNJit(const RPNJit &other)
+    : source(other.source), page(NULL), pageSize(0), entry(NULL) {
+  build();
+}
+
+RPNJit &RPNJit::operator=(const RPNJit &other) {
+  if (this != &other) {
+    release();
+    source = other.source;
+    build();
+  }
+  return *this;
+}
+
+RPNJit::~RPNJit() { release(); }
+
+const RPNProgram &RPNJit::program() const { return source; }
+
+RPNJit::Function RPNJit::function() const { return entry; }
+
+void RPNJit::release() {
+#ifdef RPN_HAVE_JIT
+  if (page)
+    munmap(page, pageSize);
+#endif
+  page = NULL;
+  pageSize = 0;
+  entry = NULL;
+}
+
+#ifdef RPN_HAVE_JIT
+typedef std::vector<unsigned char> Code;
+
+enum Register { EAX = 0, ECX = 1, R8 = 8 };
+
+// Slots 0-3 use r8d-r11d, which the ABI lets us clobber; 4-7 use r12d-r15d,
+// saved in the prologue; the rest are 4-byte cells at [rsp + 4 * (slot - 8)]
+static const unsigned int g_registerSlots = 8;
+
+static void emitInt(Code &code, int value) {
+  unsigned int bits;
+
+  bits = static_cast<unsigned int>(value);
+  for (int i = 0; i < 4; ++i)
+    code.push_back(static_cast<unsigned char>(bits >> (8 * i)));
+}
+
+static void emitRex(Code &code, int reg, int rm) {
+  if (reg >= 8 || rm >= 8)
+    code.push_back(0x40 | (reg >= 8 ? 4 : 0) | (rm >= 8 ? 1 : 0));
+}
+
+// opcode reg, r/m32 where r/m is a register
+static void emitRegisters(Code &code, const unsigned char *opcode,
+                          size_t opcodeLen, int reg, int rm) {
+  emitRex(code, reg, rm);
+  code.insert(code.end(), opcode, opcode + opcodeLen);
+  code.push_back(0xC0 | (reg & 7) << 3 | (rm & 7));
+}
+
+// opcode reg, [base + disp32] where base is rsp (4) or rdi (7)
+static void emitMemory(Code &code, unsigned char opcode, int reg, int base,
+                       int disp) {
+  emitRex(code, reg, 0);
+  code.push_back(opcode);
+  code.push_back(0x80 | (reg & 7) << 3 | base);
+  if (base == 4)
+    code.push_back(0x24);
+  emitInt(code, disp);
+}
+
+static bool inRegister(unsigned int slot) { return slot < g_registerSlots; }
+
+static int slotRegister(unsigned int slot) { return R8 + slot; }
+
+static int slotOffset(unsigned int slot) {
+  return static_cast<int>(4 * (slot - g_registerSlots));
+}
+
+static void emitLoad(Code &code, int reg, unsigned int slot) {
+  static const unsigned char mov = 0x89;
+
+  if (inRegister(slot))
+    emitRegisters(code, &mov, 1, slotRegister(slot), reg);
+  else
+    emitMemory(code, 0x8B, reg, 4, slotOffset(slot));
+}
+
+static void emitStore(Code &code, unsigned int slot, int reg) {
+  static const unsigned char mov = 0x89;
+
+  if (inRegister(slot))
+    emitRegisters(code, &mov, 1, reg, slotRegister(slot));
+  else
+    emitMemory(code, 0x89, reg, 4, slotOffset(slot));
+}
+
+static void emitPush(Code &code, unsigned int slot, int value) {
+  if (inRegister(slot)) {
+    emitRex(code, 0, slotRegister(slot));
+    code.push_back(0xB8 + (slotRegister(slot) & 7));
+  } else
+    emitMemory(code, 0xC7, 0, 4, slotOffset(slot));
+  emitInt(code, value);
+}
+
+static void emitVariable(Code &code, unsigned int slot, int variable) {
+  if (inRegister(slot))
+    emitMemory(code, 0x8B, slotRegister(slot), 7, 4 * variable);
+  else {
+    emitMemory(code, 0x8B, EAX, 7, 4 * variable);
+    emitStore(code, slot, EAX);
+  }
+}
+
+// stack[slot] op= stack[slot + 1], in place when both are registers
+static void emitArithmetic(Code &code, unsigned char op, unsigned int slot) {
+  static const unsigned char add = 0x01;
+  static const unsigned char sub = 0x29;
+  static const unsigned char imul[2] = {0x0F, 0xAF};
+  int dst;
+  int src;
+
+  dst = EAX;
+  src = ECX;
+  if (inRegister(slot + 1)) {
+    dst = slotRegister(slot);
+    src = slotRegister(slot + 1);
+  } else {
+    emitLoad(code, EAX, slot);
+    emitLoad(code, ECX, slot + 1);
+  }
+  if (op == RPNProgram::ADD)
+    emitRegisters(code, &add, 1, src, dst);
+  else if (op == RPNProgram::SUB)
+    emitRegisters(code, &sub, 1, src, dst);
+  else
+    emitRegisters(code, imul, 2, dst, src);
+  if (dst == EAX)
+    emitStore(code, slot, EAX);
+}
+
+// The jz displacement is returned so it can be pointed at the failure exit
+static size_t emitDivide(Code &code, unsigned int slot) {
+  static const unsigned char test = 0x85;
+  size_t patch;
+
+  emitLoad(code, EAX, slot);
+  emitLoad(code, ECX, slot + 1);
+  emitRegisters(code, &test, 1, ECX, ECX);
+  code.push_back(0x0F);
+  code.push_back(0x84);
+  patch = code.size();
+  emitInt(code, 0);
+  code.push_back(0x99);
+  code.push_back(0xF7);
+  code.push_back(0xF9);
+  emitStore(code, slot, EAX);
+  return patch;
+}
+
+static void patchJump(Code &code, size_t at, size_t target) {
+  int rel;
+
+  rel = static_cast<int>(target) - static_cast<int>(at + 4);
+  std::memcpy(&code[at], &rel, 4);
+}
+
+static void translate(const RPNProgram &program, Code &code) {
+  const RPNProgram::Instruction *ip;
+  std::vector<size_t> failures;
+  unsigned int saved;
+  int frame;
+  size_t done;
+
+  saved = 0;
+  if (program.maxDepth() > 4)
+    saved = program.maxDepth() < g_registerSlots ? program.maxDepth() - 4 : 4;
+  frame = 0;
+  if (program.maxDepth() > g_registerSlots)
+    frame = static_cast<int>(4 * (program.maxDepth() - g_registerSlots));
+  for (unsigned int i = 0; i < saved; ++i) {
+    code.push_back(0x41);
+    code.push_back(0x54 + i);
+  }
+  if (frame) {
+    code.push_back(0x48);
+    code.push_back(0x81);
+    code.push_back(0xEC);
+    emitInt(code, frame);
+  }
+  ip = program.code();
+  for (size_t i = 0; i < program.size(); ++i, ++ip) {
+    if (ip->opcode == RPNProgram::PUSH)
+      emitPush(code, ip->depth, ip->operand);
+    else if (ip->opcode == RPNProgram::LOAD)
+      emitVariable(code, ip->depth, ip->operand);
+    else if (ip->opcode == RPNProgram::DIV)
+      failures.push_back(emitDivide(code, ip->depth - 2));
+    else
+      emitArithmetic(code, ip->opcode, ip->depth - 2);
+  }
+  // mov [rsi], r8d; xor eax, eax
+  code.push_back(0x44);
+  code.push_back(0x89);
+  code.push_back(0x06);
+  code.push_back(0x31);
+  code.push_back(0xC0);
+  done = code.size();
+  if (frame) {
+    code.push_back(0x48);
+    code.push_back(0x81);
+    code.push_back(0xC4);
+    emitInt(code, frame);
+  }
+  for (unsigned int i = saved; i > 0; --i) {
+    code.push_back(0x41);
+    code.push_back(0x5C + i - 1);
+  }
+  code.push_back(0xC3);
+  // Failure exit: mov eax, 1; jmp done
+  for (size_t i = 0; i < failures.size(); ++i)
+    patchJump(code, failures[i], code.size());
+  code.push_back(0xB8);
+  emitInt(code, 1);
+  code.push_back(0xE9);
+  emitInt(code, 0);
+  patchJump(code, code.size() - 4, done);
+}
+#endif
+
+// Any failure here leaves entry NULL and callers on the interpreter
+void RPNJit::build() {
+#ifdef RPN_HAVE_JIT
+  Code code;
+  long unit;
+
+  if (source.size() == 0)
+    return;
+  translate(source, code);
+  unit = sysconf(_SC_PAGESIZE);
+  if (unit <= 0)
+    return;
+  pageSize = (code.size() + unit - 1) / unit * unit;
+  page = mmap(NULL, pageSize, PROT_READ | PROT_WRITE,
+              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (page == MAP_FAILED) {
+    page = NULL;
+    pageSize = 0;
+    return;
+  }
+  std::memcpy(page, &code[0], code.size());
+  if (mprotect(page, pageSize, PROT_READ | PROT_EXEC) != 0) {
+    release();
+    return;
+  }
+  entry = reinterpret_cast<Function>(page);
+#endif
+}
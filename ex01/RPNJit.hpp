@@ -0,0 +1,47 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RPNJit.hpp                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:43:40 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:43:40 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RPN_JIT__HPP
+#define RPN_JIT__HPP
+#include "RPNProgram.hpp"
+#include <cstddef>
+
+// An RPNProgram translated to x86-64 machine code in its own executable
+// page. The first eight stack slots live in registers and deeper ones in
+// the native stack frame. The generated function reads variables from the
+// same array as RPNBindings::values() and does not divide by zero: it
+// returns nonzero instead, so the caller can rerun the interpreter.
+class RPNJit {
+  public:
+    // 0 with the value stored in *result, or nonzero on division by zero
+    typedef int (*Function)(const int *values, int *result);
+
+    RPNJit();
+    explicit RPNJit(const RPNProgram &program);
+    RPNJit(const RPNJit &other);
+    RPNJit &operator=(const RPNJit &other);
+    ~RPNJit();
+
+    const RPNProgram &program() const;
+    // NULL when no native code could be generated on this machine
+    Function function() const;
+
+  private:
+    RPNProgram source;
+    void *page;
+    size_t pageSize;
+    Function entry;
+
+    void build();
+    void release();
+};
+#endif
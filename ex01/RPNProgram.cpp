@@ -0,0 +1,217 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RPNProgram.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:36:24 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 02:30:06 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "RPNProgram.hpp"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+static bool isSpace(char c) {
+  return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+static bool isIdentifier(const std::string &token) {
+  if (!std::isalpha(static_cast<unsigned char>(token[0])) && token[0] != '_')
+    return false;
+  for (size_t i = 1; i < token.size(); ++i) {
+    if (!std::isalnum(static_cast<unsigned char>(token[i])) && token[i] != '_')
+      return false;
+  }
+  return true;
+}
+
+RPNProgram::RPNProgram() : depth(0) {}
+
+// Same tokens and errors as RPN::evaluate, plus variable names
+RPNProgram::RPNProgram(const std::string &expr) : depth(0) {
+  size_t stackSize;
+  size_t pos;
+  size_t end;
+  size_t slot;
+
+  stackSize = 0;
+  pos = 0;
+  while (true) {
+    while (pos < expr.size() && isSpace(expr[pos]))
+      ++pos;
+    if (pos == expr.size())
+      break;
+    end = pos;
+    while (end < expr.size() && !isSpace(expr[end]))
+      ++end;
+    std::string token(expr, pos, end - pos);
+    pos = end;
+    if (token.size() == 1 && std::isdigit(static_cast<unsigned char>(token[0])))
+      emit(PUSH, token[0] - '0', stackSize);
+    else if (token == "+")
+      emit(ADD, 0, stackSize);
+    else if (token == "-")
+      emit(SUB, 0, stackSize);
+    else if (token == "*")
+      emit(MUL, 0, stackSize);
+    else if (token == "/")
+      emit(DIV, 0, stackSize);
+    else if (isIdentifier(token)) {
+      slot = this->slot(token);
+      if (slot == variables.size())
+        variables.push_back(token);
+      emit(LOAD, static_cast<int>(slot), stackSize);
+    } else
+      throw std::runtime_error("invalid token");
+  }
+  if (stackSize != 1)
+    throw std::runtime_error("invalid expression");
+  // Folding can leave the deepest point of the raw expression unused
+  depth = 0;
+  for (size_t i = 0; i < instructions.size(); ++i) {
+    if (instructions[i].opcode == PUSH || instructions[i].opcode == LOAD)
+      depth = std::max<size_t>(depth, instructions[i].depth + 1);
+  }
+}
+
+RPNProgram::RPNProgram(const RPNProgram &other)
+    : instructions(other.instructions), variables(other.variables),
+      depth(other.depth) {}
+
+RPNProgram &RPNProgram::operator=(const RPNProgram &other) {
+  if (this != &other) {
+    instructions = other.instructions;
+    variables = other.variables;
+    depth = other.depth;
+  }
+  return *this;
+}
+
+RPNProgram::~RPNProgram() {}
+
+// Appends one instruction, tracking the stack size it leaves behind
+void RPNProgram::emit(unsigned char opcode, int operand, size_t &stackSize) {
+  Instruction ins;
+
+  ins.opcode = opcode;
+  ins.depth = static_cast<unsigned int>(stackSize);
+  ins.operand = operand;
+  if (opcode == PUSH || opcode == LOAD) {
+    ++stackSize;
+    if (stackSize > depth)
+      depth = stackSize;
+  } else {
+    if (stackSize < 2)
+      throw std::runtime_error("invalid expression");
+    --stackSize;
+    if (fold(opcode))
+      return;
+  }
+  instructions.push_back(ins);
+}
+
+// An operator on two constants becomes one constant, so constant subtrees
+// collapse as they are emitted. Divisions that would throw or trap are
+// left for evaluation to report.
+bool RPNProgram::fold(unsigned char opcode) {
+  size_t n;
+  unsigned int a;
+  unsigned int b;
+
+  n = instructions.size();
+  if (n < 2 || instructions[n - 1].opcode != PUSH ||
+      instructions[n - 2].opcode != PUSH)
+    return false;
+  a = static_cast<unsigned int>(instructions[n - 2].operand);
+  b = static_cast<unsigned int>(instructions[n - 1].operand);
+  if (opcode == ADD)
+    a += b;
+  else if (opcode == SUB)
+    a -= b;
+  else if (opcode == MUL)
+    a *= b;
+  else if (b == 0 || (a == 0x80000000u && b == 0xFFFFFFFFu))
+    return false;
+  else
+    a = static_cast<unsigned int>(static_cast<int>(a) / static_cast<int>(b));
+  instructions[n - 2].operand = static_cast<int>(a);
+  instructions.pop_back();
+  return true;
+}
+
+const RPNProgram::Instruction *RPNProgram::code() const {
+  return instructions.empty() ? NULL : &instructions[0];
+}
+
+size_t RPNProgram::size() const { return instructions.size(); }
+
+size_t RPNProgram::maxDepth() const { return depth; }
+
+size_t RPNProgram::variableCount() const { return variables.size(); }
+
+const std::string &RPNProgram::variable(size_t slot) const {
+  return variables.at(slot);
+}
+
+size_t RPNProgram::slot(const std::string &name) const {
+  size_t i;
+
+  for (i = 0; i < variables.size(); ++i) {
+    if (variables[i] == name)
+      break;
+  }
+  return i;
+}
+
+RPNBindings::RPNBindings() {}
+
+RPNBindings::RPNBindings(const RPNProgram &program)
+    : slots(program.variableCount(), 0), stack(program.maxDepth()) {
+  for (size_t i = 0; i < program.variableCount(); ++i)
+    names.push_back(program.variable(i));
+}
+
+RPNBindings::RPNBindings(const RPNBindings &other)
+    : names(other.names), slots(other.slots), stack(other.stack) {}
+
+RPNBindings &RPNBindings::operator=(const RPNBindings &other) {
+  if (this != &other) {
+    names = other.names;
+    slots = other.slots;
+    stack = other.stack;
+  }
+  return *this;
+}
+
+RPNBindings::~RPNBindings() {}
+
+void RPNBindings::set(const std::string &name, int value) {
+  for (size_t i = 0; i < names.size(); ++i) {
+    if (names[i] == name) {
+      slots[i] = value;
+      return;
+    }
+  }
+  throw std::runtime_error("unknown variable");
+}
+
+void RPNBindings::set(size_t slot, int value) { slots.at(slot) = value; }
+
+int RPNBindings::get(size_t slot) const { return slots.at(slot); }
+
+size_t RPNBindings::size() const { return slots.size(); }
+
+const int *RPNBindings::values() const {
+  return slots.empty() ? NULL : &slots[0];
+}
+
+// At least depth entries; only grows when bound to a deeper program
+int *RPNBindings::scratch(size_t depth) {
+  if (stack.size() < depth)
+    stack.resize(depth);
+  return stack.empty() ? NULL : &stack[0];
+}
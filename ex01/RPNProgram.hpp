@@ -0,0 +1,83 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RPNProgram.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:36:12 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 02:30:06 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RPN_PROGRAM__HPP
+#define RPN_PROGRAM__HPP
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// An RPN expression validated once and lowered to linear bytecode. Each
+// instruction records the stack depth it runs at, so evaluation indexes
+// the stack directly instead of tracking its size. Besides single digits
+// and + - * /, an expression may name variables ([A-Za-z_][A-Za-z0-9_]*),
+// whose values come from an RPNBindings at evaluation time. Operators
+// whose operands are both constants are folded at compile time.
+class RPNProgram {
+  public:
+    enum Opcode { PUSH, LOAD, ADD, SUB, MUL, DIV };
+
+    struct Instruction {
+        unsigned char opcode;
+        unsigned int depth;
+        int operand;
+    };
+
+    RPNProgram();
+    explicit RPNProgram(const std::string &expr);
+    RPNProgram(const RPNProgram &other);
+    RPNProgram &operator=(const RPNProgram &other);
+    ~RPNProgram();
+
+    const Instruction *code() const;
+    size_t size() const;
+    size_t maxDepth() const;
+    size_t variableCount() const;
+    const std::string &variable(size_t slot) const;
+    // Slot of a variable, or variableCount() when the name is not used
+    size_t slot(const std::string &name) const;
+
+  private:
+    std::vector<Instruction> instructions;
+    std::vector<std::string> variables;
+    size_t depth;
+
+    void emit(unsigned char opcode, int operand, size_t &stackSize);
+    bool fold(unsigned char opcode);
+};
+
+// Variable values for programs with a given set of slots, plus the scratch
+// stack evaluation runs on, so that evaluating allocates nothing. Evaluation
+// writes that stack, so it takes the bindings by non-const reference and
+// each thread needs its own instance.
+class RPNBindings {
+  public:
+    RPNBindings();
+    explicit RPNBindings(const RPNProgram &program);
+    RPNBindings(const RPNBindings &other);
+    RPNBindings &operator=(const RPNBindings &other);
+    ~RPNBindings();
+
+    void set(const std::string &name, int value);
+    void set(size_t slot, int value);
+    int get(size_t slot) const;
+    size_t size() const;
+
+    const int *values() const;
+    int *scratch(size_t depth);
+
+  private:
+    std::vector<std::string> names;
+    std::vector<int> slots;
+    std::vector<int> stack;
+};
+#endif
@@ -0,0 +1,105 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RPNRational.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:53:46 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:57:59 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "RPNRational.hpp"
+#include <stdexcept>
+
+RPNRational::RPNRational() : num(0), den(1) {}
+
+RPNRational::RPNRational(const RPNBigInt &value) : num(value), den(1) {}
+
+// Reduces value / divisor, where divisor is not zero
+RPNRational::RPNRational(const RPNBigInt &value, const RPNBigInt &divisor)
+    : num(value), den(divisor) {
+  RPNBigInt common;
+
+  if (den.isNegative()) {
+    num = -num;
+    den = -den;
+  }
+  common = RPNBigInt::gcd(num, den);
+  if (common.compare(1) != 0) {
+    num = num / common;
+    den = den / common;
+  }
+}
+
+RPNRational::RPNRational(const RPNRational &other)
+    : num(other.num), den(other.den) {}
+
+RPNRational &RPNRational::operator=(const RPNRational &other) {
+  if (this != &other) {
+    num = other.num;
+    den = other.den;
+  }
+  return *this;
+}
+
+RPNRational::~RPNRational() {}
+
+RPNRational RPNRational::operator+(const RPNRational &other) const {
+  if (den.compare(other.den) == 0)
+    return RPNRational(num + other.num, den);
+  return RPNRational(num * other.den + other.num * den, den * other.den);
+}
+
+RPNRational RPNRational::operator-(const RPNRational &other) const {
+  if (den.compare(other.den) == 0)
+    return RPNRational(num - other.num, den);
+  return RPNRational(num * other.den - other.num * den, den * other.den);
+}
+
+// Cancelling across first leaves the product in lowest terms and keeps
+// the operands small
+RPNRational RPNRational::operator*(const RPNRational &other) const {
+  RPNRational result;
+  RPNBigInt a;
+  RPNBigInt b;
+
+  if (num.isZero() || other.num.isZero())
+    return result;
+  a = RPNBigInt::gcd(num, other.den);
+  b = RPNBigInt::gcd(other.num, den);
+  result.num = (num / a) * (other.num / b);
+  result.den = (den / b) * (other.den / a);
+  return result;
+}
+
+RPNRational RPNRational::operator/(const RPNRational &other) const {
+  RPNRational result;
+  RPNBigInt a;
+  RPNBigInt b;
+
+  if (other.num.isZero())
+    throw std::runtime_error("division by zero");
+  if (num.isZero())
+    return result;
+  a = RPNBigInt::gcd(num, other.num);
+  b = RPNBigInt::gcd(den, other.den);
+  result.num = (num / a) * (other.den / b);
+  result.den = (den / b) * (other.num / a);
+  if (result.den.isNegative()) {
+    result.num = -result.num;
+    result.den = -result.den;
+  }
+  return result;
+}
+
+const RPNBigInt &RPNRational::numerator() const { return num; }
+
+const RPNBigInt &RPNRational::denominator() const { return den; }
+
+std::string RPNRational::toString() const {
+  if (den.compare(1) == 0)
+    return num.toString();
+  return num.toString() + "/" + den.toString();
+}
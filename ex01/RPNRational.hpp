@@ -0,0 +1,44 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RPNRational.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:53:46 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:57:59 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RPN_RATIONAL__HPP
+#define RPN_RATIONAL__HPP
+#include "RPNBigInt.hpp"
+#include <string>
+
+// An exact fraction, kept in lowest terms with a positive denominator
+class RPNRational {
+  public:
+    RPNRational();
+    RPNRational(const RPNBigInt &value);
+    RPNRational(const RPNRational &other);
+    RPNRational &operator=(const RPNRational &other);
+    ~RPNRational();
+
+    RPNRational operator+(const RPNRational &other) const;
+    RPNRational operator-(const RPNRational &other) const;
+    RPNRational operator*(const RPNRational &other) const;
+    // Throws "division by zero"
+    RPNRational operator/(const RPNRational &other) const;
+
+    const RPNBigInt &numerator() const;
+    const RPNBigInt &denominator() const;
+    // "p/q", or just "p" for an integer
+    std::string toString() const;
+
+  private:
+    RPNBigInt num;
+    RPNBigInt den;
+
+    RPNRational(const RPNBigInt &value, const RPNBigInt &divisor);
+};
+#endif
@@ -0,0 +1,372 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RPNStatic.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:50:09 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 00:50:09 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RPN_STATIC__HPP
+#define RPN_STATIC__HPP
+#include "RPNProgram.hpp"
+#include <cstddef>
+#include <stdexcept>
+
+// Compile-time counterpart of RPNProgram for formulas fixed at build time.
+// C++98 cannot take a string literal as a template argument, so the
+// expression is spelled one character per argument, up to 48:
+//
+//     RPNStatic<'3', ' ', '4', ' ', '+'>::value              // 7
+//     RPNStatic<'x', ' ', '2', ' ', '*'>::evaluate(values)   // x * 2
+//
+// Tokens are those of RPNProgram, and variables take slots in order of
+// first use, so values is laid out like RPNBindings::values() for the same
+// text. Constant subtrees are folded and the rest becomes one inlined
+// function. An invalid token, a malformed expression or a division by the
+// constant 0 does not compile, and the diagnostic names the error.
+namespace rpn_static {
+    struct invalid_token;
+    struct invalid_expression;
+    struct division_by_zero;
+
+    // Has no type, so naming it stops compilation, unless Ok
+    template <bool Ok, class Error> struct Require {
+        typedef int type;
+    };
+    template <class Error> struct Require<false, Error> {};
+
+    // Always false, but only once T is known, so that a failing Require
+    // in a template is reported when that template is used
+    template <class T> struct Never {
+        static const bool value = false;
+    };
+
+    struct End;
+    template <char C, class Next> struct Chars;
+
+    struct Nil;
+    template <class Head, class Tail> struct Cons;
+
+    template <class A, class B> struct Same {
+        static const bool value = false;
+    };
+    template <class A> struct Same<A, A> {
+        static const bool value = true;
+    };
+
+    template <class List> struct Length {
+        static const int value = 0;
+    };
+    template <class H, class T> struct Length<Cons<H, T> > {
+        static const int value = Length<T>::value + 1;
+    };
+
+    // Position of Item in List, or -1
+    template <class List, class Item> struct IndexOf {
+        static const int value = -1;
+    };
+    template <class H, class T, class Item>
+    struct IndexOf<Cons<H, T>, Item> {
+        static const int rest = IndexOf<T, Item>::value;
+        static const int value =
+            Same<H, Item>::value ? 0 : rest < 0 ? -1 : rest + 1;
+    };
+
+    template <class List, class Item> struct Append {
+        typedef Cons<Item, Nil> type;
+    };
+    template <class H, class T, class Item> struct Append<Cons<H, T>, Item> {
+        typedef Cons<H, typename Append<T, Item>::type> type;
+    };
+
+    // The characters up to the first '\0'
+    template <class List> struct Terminate {
+        typedef End type;
+    };
+    template <char C, class N> struct Terminate<Chars<C, N> > {
+        typedef Chars<C, typename Terminate<N>::type> type;
+    };
+    template <class N> struct Terminate<Chars<'\0', N> > {
+        typedef End type;
+    };
+
+    // The expression as a list of its characters
+    template <char C0, char C1 = 0, char C2 = 0, char C3 = 0, char C4 = 0,
+              char C5 = 0, char C6 = 0, char C7 = 0, char C8 = 0, char C9 = 0,
+              char C10 = 0, char C11 = 0, char C12 = 0, char C13 = 0,
+              char C14 = 0, char C15 = 0, char C16 = 0, char C17 = 0,
+              char C18 = 0, char C19 = 0, char C20 = 0, char C21 = 0,
+              char C22 = 0, char C23 = 0, char C24 = 0, char C25 = 0,
+              char C26 = 0, char C27 = 0, char C28 = 0, char C29 = 0,
+              char C30 = 0, char C31 = 0, char C32 = 0, char C33 = 0,
+              char C34 = 0, char C35 = 0, char C36 = 0, char C37 = 0,
+              char C38 = 0, char C39 = 0, char C40 = 0, char C41 = 0,
+              char C42 = 0, char C43 = 0, char C44 = 0, char C45 = 0,
+              char C46 = 0, char C47 = 0>
+    struct Text {
+        typedef typename Terminate<Chars<C0, Chars<C1, Chars<C2, Chars<C3,
+            Chars<C4, Chars<C5, Chars<C6, Chars<C7, Chars<C8, Chars<C9,
+            Chars<C10, Chars<C11, Chars<C12, Chars<C13, Chars<C14, Chars<C15,
+            Chars<C16, Chars<C17, Chars<C18, Chars<C19, Chars<C20, Chars<C21,
+            Chars<C22, Chars<C23, Chars<C24, Chars<C25, Chars<C26, Chars<C27,
+            Chars<C28, Chars<C29, Chars<C30, Chars<C31, Chars<C32, Chars<C33,
+            Chars<C34, Chars<C35, Chars<C36, Chars<C37, Chars<C38, Chars<C39,
+            Chars<C40, Chars<C41, Chars<C42, Chars<C43, Chars<C44, Chars<C45,
+            Chars<C46, Chars<C47, End> > > > > > > > > > > > > > > > > > > > > >
+            > > > > > > > > > > > > > > > > > > > > > > > > > > >::type
+            type;
+    };
+
+    // std::isspace() in the "C" locale
+    template <char C> struct IsSpace {
+        static const bool value = C == ' ' || (C >= '\t' && C <= '\r');
+    };
+
+    template <char C> struct IsIdentifierStart {
+        static const bool value =
+            (C >= 'a' && C <= 'z') || (C >= 'A' && C <= 'Z') || C == '_';
+    };
+
+    template <class List> struct IsIdentifierRest {
+        static const bool value = true;
+    };
+    template <char C, class N> struct IsIdentifierRest<Chars<C, N> > {
+        static const bool value =
+            (IsIdentifierStart<C>::value || (C >= '0' && C <= '9')) &&
+            IsIdentifierRest<N>::value;
+    };
+
+    // The token a list starts with, and what follows it
+    template <class List> struct Split {
+        typedef End token;
+        typedef End rest;
+    };
+    template <bool Space, char C, class N> struct SplitAt {
+        typedef End token;
+        typedef Chars<C, N> rest;
+    };
+    template <char C, class N> struct SplitAt<false, C, N> {
+        typedef Chars<C, typename Split<N>::token> token;
+        typedef typename Split<N>::rest rest;
+    };
+    template <char C, class N>
+    struct Split<Chars<C, N> > : SplitAt<IsSpace<C>::value, C, N> {};
+
+    enum Kind { DIGIT, OPERATOR, VARIABLE, INVALID };
+
+    template <class Token> struct Classify {
+        static const int value = INVALID;
+    };
+    template <char C, char D, class N>
+    struct Classify<Chars<C, Chars<D, N> > > {
+        static const int value = IsIdentifierStart<C>::value &&
+                                         IsIdentifierRest<Chars<D, N> >::value
+                                     ? VARIABLE
+                                     : INVALID;
+    };
+    template <char C> struct Classify<Chars<C, End> > {
+        static const int value =
+            C >= '0' && C <= '9'                           ? DIGIT
+            : C == '+' || C == '-' || C == '*' || C == '/' ? OPERATOR
+            : IsIdentifierStart<C>::value                  ? VARIABLE
+                                                           : INVALID;
+    };
+
+    template <char C> struct Opcode {
+        static const int value = C == '+'   ? RPNProgram::ADD
+                                 : C == '-' ? RPNProgram::SUB
+                                 : C == '*' ? RPNProgram::MUL
+                                            : RPNProgram::DIV;
+    };
+
+    // Wraps on overflow like the runtime evaluators in practice, and lets
+    // INT_MIN / -1 trap like theirs
+    inline int apply(int op, int a, int b) {
+        unsigned int x;
+        unsigned int y;
+
+        x = static_cast<unsigned int>(a);
+        y = static_cast<unsigned int>(b);
+        if (op == RPNProgram::ADD)
+            return static_cast<int>(x + y);
+        if (op == RPNProgram::SUB)
+            return static_cast<int>(x - y);
+        if (op == RPNProgram::MUL)
+            return static_cast<int>(x * y);
+        if (b == 0)
+            throw std::runtime_error("division by zero");
+        return a / b;
+    }
+
+    template <int Value> struct Constant {
+        static int evaluate(const int *) { return Value; }
+    };
+
+    template <int Slot> struct Variable {
+        static int evaluate(const int *values) { return values[Slot]; }
+    };
+
+    // The left operand is evaluated first, as on the runtime stack
+    template <int Op, class Left, class Right> struct Node {
+        static int evaluate(const int *values) {
+            int a;
+
+            a = Left::evaluate(values);
+            return apply(Op, a, Right::evaluate(values));
+        }
+    };
+
+    template <int Op, int A, int B> struct Fold {
+        static const unsigned int x = static_cast<unsigned int>(A);
+        static const unsigned int y = static_cast<unsigned int>(B);
+        static const int value =
+            Op == RPNProgram::ADD   ? static_cast<int>(x + y)
+            : Op == RPNProgram::SUB ? static_cast<int>(x - y)
+            : Op == RPNProgram::MUL ? static_cast<int>(x * y)
+                                    : A / (B ? B : 1);
+    };
+    template <int A> struct Fold<RPNProgram::DIV, A, -1> {
+        typedef typename Require<A != -2147483647 - 1,
+                                 division_by_zero>::type representable;
+        static const int value = A == -2147483647 - 1 ? A : -A;
+    };
+
+    template <int Op, class Left, class Right> struct Combine {
+        typedef Node<Op, Left, Right> type;
+    };
+    template <int Op, int A, int B>
+    struct Combine<Op, Constant<A>, Constant<B> > {
+        typedef Constant<Fold<Op, A, B>::value> type;
+    };
+    template <class Left> struct Combine<RPNProgram::DIV, Left, Constant<0> > {
+        typedef typename Require<Never<Left>::value, division_by_zero>::type
+            type;
+    };
+    template <int A>
+    struct Combine<RPNProgram::DIV, Constant<A>, Constant<0> > {
+        typedef typename Require<Never<Constant<A> >::value,
+                                 division_by_zero>::type type;
+    };
+
+    template <bool Found, class Variables, class Token> struct Declare {
+        typedef typename Append<Variables, Token>::type type;
+    };
+    template <class Variables, class Token>
+    struct Declare<true, Variables, Token> {
+        typedef Variables type;
+    };
+
+    // One token's effect on the stack of subtrees and the variable list
+    template <int Kind, class Token, class Stack, class Variables>
+    struct Apply {
+        typedef typename Require<Never<Token>::value, invalid_token>::type
+            stack;
+        typedef Variables variables;
+    };
+    template <char C, class Stack, class Variables>
+    struct Apply<DIGIT, Chars<C, End>, Stack, Variables> {
+        typedef Cons<Constant<C - '0'>, Stack> stack;
+        typedef Variables variables;
+    };
+    template <class Token, class Stack, class Variables>
+    struct Apply<VARIABLE, Token, Stack, Variables> {
+        static const int found = IndexOf<Variables, Token>::value;
+        static const int slot = found < 0 ? Length<Variables>::value : found;
+        typedef Cons<Variable<slot>, Stack> stack;
+        typedef typename Declare<found >= 0, Variables, Token>::type
+            variables;
+    };
+    template <int Op, class Stack> struct Reduce {
+        typedef typename Require<Never<Stack>::value,
+                                 invalid_expression>::type stack;
+    };
+    template <int Op, class Right, class Left, class Rest>
+    struct Reduce<Op, Cons<Right, Cons<Left, Rest> > > {
+        typedef Cons<typename Combine<Op, Left, Right>::type, Rest> stack;
+    };
+    template <char C, class Stack, class Variables>
+    struct Apply<OPERATOR, Chars<C, End>, Stack, Variables> {
+        typedef typename Reduce<Opcode<C>::value, Stack>::stack stack;
+        typedef Variables variables;
+    };
+
+    template <class List, class Stack, class Variables> struct Parse {
+        typedef Stack stack;
+        typedef Variables variables;
+    };
+    template <bool Space, class List, class Stack, class Variables>
+    struct ParseToken {
+        typedef typename Split<List>::token token;
+        typedef Apply<Classify<token>::value, token, Stack, Variables> step;
+        typedef Parse<typename Split<List>::rest, typename step::stack,
+                      typename step::variables>
+            next;
+        typedef typename next::stack stack;
+        typedef typename next::variables variables;
+    };
+    template <char C, class N, class Stack, class Variables>
+    struct ParseToken<true, Chars<C, N>, Stack, Variables>
+        : Parse<N, Stack, Variables> {};
+    template <char C, class N, class Stack, class Variables>
+    struct Parse<Chars<C, N>, Stack, Variables>
+        : ParseToken<IsSpace<C>::value, Chars<C, N>, Stack, Variables> {};
+
+    // The expression must leave exactly one value
+    template <class Stack> struct Root {
+        typedef typename Require<Never<Stack>::value,
+                                 invalid_expression>::type type;
+    };
+    template <class Tree> struct Root<Cons<Tree, Nil> > {
+        typedef Tree type;
+    };
+
+    // value only exists when the whole expression folded to a constant
+    template <class Tree> struct Result {};
+    template <int Value> struct Result<Constant<Value> > {
+        static const int value = Value;
+    };
+    template <int Value> const int Result<Constant<Value> >::value;
+
+    template <class Text>
+    struct Compile
+        : Result<typename Root<
+              typename Parse<typename Text::type, Nil, Nil>::stack>::type> {
+        typedef Parse<typename Text::type, Nil, Nil> parsed;
+        typedef typename Root<typename parsed::stack>::type tree;
+
+        static const size_t variableCount =
+            Length<typename parsed::variables>::value;
+
+        static int evaluate(const int *values) {
+            return tree::evaluate(values);
+        }
+
+        static int evaluate(const RPNBindings &bindings) {
+            if (bindings.size() != variableCount)
+                throw std::runtime_error("bindings do not match the program");
+            return tree::evaluate(bindings.values());
+        }
+    };
+    template <class Text> const size_t Compile<Text>::variableCount;
+}
+
+template <char C0, char C1 = 0, char C2 = 0, char C3 = 0, char C4 = 0,
+          char C5 = 0, char C6 = 0, char C7 = 0, char C8 = 0, char C9 = 0,
+          char C10 = 0, char C11 = 0, char C12 = 0, char C13 = 0, char C14 = 0,
+          char C15 = 0, char C16 = 0, char C17 = 0, char C18 = 0, char C19 = 0,
+          char C20 = 0, char C21 = 0, char C22 = 0, char C23 = 0, char C24 = 0,
+          char C25 = 0, char C26 = 0, char C27 = 0, char C28 = 0, char C29 = 0,
+          char C30 = 0, char C31 = 0, char C32 = 0, char C33 = 0, char C34 = 0,
+          char C35 = 0, char C36 = 0, char C37 = 0, char C38 = 0, char C39 = 0,
+          char C40 = 0, char C41 = 0, char C42 = 0, char C43 = 0, char C44 = 0,
+          char C45 = 0, char C46 = 0, char C47 = 0>
+class RPNStatic
+    : public rpn_static::Compile<rpn_static::Text<C0, C1, C2, C3, C4, C5, C6,
+          C7, C8, C9, C10, C11, C12, C13, C14, C15, C16, C17, C18, C19, C20,
+          C21, C22, C23, C24, C25, C26, C27, C28, C29, C30, C31, C32, C33, C34,
+          C35, C36, C37, C38, C39, C40, C41, C42, C43, C44, C45, C46, C47> > {};
+#endif
@@ -6,16 +6,114 @@
 /*   By: igngonza <igngonza@student.42madrid.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/02/10 12:14:27 by igngonza          #+#    #+#             */
-/*   Updated: 2026/02/10 12:46:18 by igngonza         ###   ########.fr       */
+/*   Updated: 2026/10/18 00:57:59 by igngonza         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "RPN.hpp"
+#include "RPNBatch.hpp"
+#include "RPNCache.hpp"
+#include <cstdlib>
 #include <exception>
+#include <fcntl.h>
 #include <iostream>
+#include <string>
+#include <unistd.h>
+
+// A whole decimal number in [1, max], or 0
+static long parseCount(const char *str, long max) {
+    char *end;
+    long value;
+
+    value = std::strtol(str, &end, 10);
+    if (*str == '\0' || *end != '\0' || value < 1 || value > max)
+        return 0;
+    return value;
+}
+
+// RPN --batch [-j N] [-c N] [file]: one expression per line from file or
+// stdin; -c caches up to N results and reports the cache counters
+static int runBatch(int argc, char **argv) {
+    long workers;
+    long entries;
+    int arg;
+    int fd;
+    bool ok;
+
+    workers = sysconf(_SC_NPROCESSORS_ONLN);
+    entries = 0;
+    arg = 2;
+    while (arg + 1 < argc && (std::string(argv[arg]) == "-j" ||
+                              std::string(argv[arg]) == "-c")) {
+        if (std::string(argv[arg]) == "-j") {
+            workers = parseCount(argv[arg + 1], 1024);
+            if (!workers) {
+                std::cerr << "Error: invalid worker count" << std::endl;
+                return 1;
+            }
+        } else {
+            entries = parseCount(argv[arg + 1], 1L << 24);
+            if (!entries) {
+                std::cerr << "Error: invalid cache size" << std::endl;
+                return 1;
+            }
+        }
+        arg += 2;
+    }
+    if (argc - arg > 1) {
+        std::cerr << "Error: too many arguments" << std::endl;
+        return 1;
+    }
+    fd = arg < argc ? open(argv[arg], O_RDONLY) : STDIN_FILENO;
+    if (fd < 0) {
+        std::cerr << "Error: could not open file" << std::endl;
+        return 1;
+    }
+    RPNCache cache(entries ? entries : 1);
+    ok = RPNBatch(workers > 0 ? workers : 1, entries ? &cache : NULL).run(fd);
+    if (fd != STDIN_FILENO)
+        close(fd);
+    if (entries)
+        std::cerr << "cache: " << cache.hits() << " hits, " << cache.misses()
+                  << " misses, " << cache.evictions() << " evictions"
+                  << std::endl;
+    if (!ok) {
+        std::cerr << "Error: could not read input" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// RPN --int64|--rational|--bigint expr: multi-digit literals, with
+// overflow reported, exact fractions, or integers of any size
+static int runExact(const std::string &flag, const char *expr) {
+    RPN::Arithmetic mode;
+
+    if (flag == "--int64")
+        mode = RPN::CHECKED_INT64;
+    else if (flag == "--rational")
+        mode = RPN::RATIONAL;
+    else if (flag == "--bigint")
+        mode = RPN::BIG_INTEGER;
+    else {
+        std::cerr << "Error: unknown option " << flag << std::endl;
+        return 1;
+    }
+    try {
+        std::cout << RPN().evaluate(expr, mode) << std::endl;
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
 
 int main(int argc, char **argv) {
 
+    if (argc >= 2 && std::string(argv[1]) == "--batch")
+        return runBatch(argc, argv);
+    if (argc == 3 && argv[1][0] == '-' && argv[1][1] == '-')
+        return runExact(argv[1], argv[2]);
     if (argc != 2) {
         std::cerr << "Error: must have two arguments" << std::endl;
         return 1;
@@ -0,0 +1,106 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   alloc.cpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:28:44 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 02:52:28 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../RPN.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+// Checks that evaluating an expression string never calls operator new
+
+static size_t g_allocations = 0;
+
+void *operator new(size_t size) throw(std::bad_alloc) {
+    void *p;
+
+    ++g_allocations;
+    p = std::malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void *operator new[](size_t size) throw(std::bad_alloc) {
+    return operator new(size);
+}
+
+void operator delete(void *p) throw() { std::free(p); }
+
+void operator delete[](void *p) throw() { std::free(p); }
+
+// Evaluates expr and fails unless it gives expected without allocating
+static bool check(const char *name, const std::string &expr, int expected) {
+    RPN rpn;
+    size_t before;
+    int result;
+
+    before = g_allocations;
+    result = rpn.evaluate(expr);
+    if (g_allocations != before || result != expected) {
+        std::cerr << name << ": " << g_allocations - before
+                  << " allocations, result " << result << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// An expression deeper than the local stack may allocate, but must still
+// evaluate like any other
+static bool checkDeep(size_t depth) {
+    RPN rpn;
+    std::string expr;
+    int result;
+
+    for (size_t i = 0; i < depth; ++i)
+        expr += "1 ";
+    for (size_t i = 1; i < depth; ++i)
+        expr += i > 1 ? " +" : "+";
+    try {
+        result = rpn.evaluate(expr);
+    } catch (const std::exception &e) {
+        std::cerr << "depth " << depth << ": " << e.what() << std::endl;
+        return false;
+    }
+    if (result != static_cast<int>(depth)) {
+        std::cerr << "depth " << depth << ": result " << result << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    std::string chain;
+    std::string deep;
+    bool ok;
+
+    // 1 followed by 5000 "1 +": far longer than the stack, but 2 deep
+    chain = "1";
+    for (int i = 0; i < 5000; ++i)
+        chain += " 1 +";
+    // 1000 ones then 999 "+": deep, but within the local stack
+    for (int i = 0; i < 1000; ++i)
+        deep += "1 ";
+    for (int i = 0; i < 999; ++i)
+        deep += i ? " +" : "+";
+    ok = check("short", "8 9 * 9 - 9 - 9 - 4 - 1 +", 42);
+    ok = check("operators", "7 7 * 7 -", 42) && ok;
+    ok = check("division", "1 2 * 2 / 2 * 2 4 - +", 0) && ok;
+    ok = check("long", chain, 5001) && ok;
+    ok = check("deep", deep, 1000) && ok;
+    ok = checkDeep(1100) && ok;
+    ok = checkDeep(100000) && ok;
+    if (!ok)
+        return 1;
+    std::cout << "alloc: ok" << std::endl;
+    return 0;
+}
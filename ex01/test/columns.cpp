@@ -0,0 +1,104 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   columns.cpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 03:08:35 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 03:09:34 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+#include "../RPN.hpp"
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// evaluateColumns against evaluate(Program, Bindings&) row by row: stacks
+// deeper than eight, divisors that are zero in some rows only, and row
+// counts that leave a partial SIMD group or cross a block of 1024
+
+static const char *const g_exprs[] = {
+    "a b c a b c a b c a b c + - * + - + - + - + *",
+    "1 2 3 4 5 6 7 8 a b / + + + + + + + +",
+    "a 1 2 3 4 5 6 7 8 9 c - + * - + - + - b / + -",
+    "a b - c /",
+    "a b /",
+};
+
+static const size_t g_rows[] = {1, 3, 5, 7, 9, 13, 1023, 1025, 2051};
+
+// Small values, so no expression above overflows; b and c are zero in
+// some rows
+static int value(size_t slot, size_t row) {
+    return static_cast<int>((row * (slot * 7 + 3) + slot) % 23) - 11;
+}
+
+static bool check(const RPN &rpn, const char *expr, size_t rows) {
+    RPN::Program program = rpn.compile(expr);
+    RPN::Bindings bindings(program);
+    std::vector<std::vector<int> > data(program.variableCount());
+    std::vector<const int *> columns(program.variableCount());
+    std::vector<int> results(rows);
+    std::vector<unsigned char> failed(rows);
+    bool anyFailed;
+    bool threw;
+    int expected;
+
+    for (size_t s = 0; s < data.size(); ++s) {
+        data[s].resize(rows);
+        for (size_t row = 0; row < rows; ++row)
+            data[s][row] = value(s, row);
+        columns[s] = &data[s][0];
+    }
+    rpn.evaluateColumns(program, &columns[0], rows, &results[0], &failed[0]);
+    anyFailed = false;
+    for (size_t row = 0; row < rows; ++row) {
+        for (size_t s = 0; s < data.size(); ++s)
+            bindings.set(s, data[s][row]);
+        try {
+            expected = rpn.evaluate(program, bindings);
+            threw = false;
+        } catch (const std::exception &) {
+            expected = 0;
+            threw = true;
+        }
+        anyFailed = anyFailed || threw;
+        if (failed[row] != threw || results[row] != expected) {
+            std::cerr << expr << ", " << rows << " rows, row " << row << ": "
+                      << results[row] << (failed[row] ? " (failed)" : "")
+                      << ", expected " << expected
+                      << (threw ? " (failed)" : "") << std::endl;
+            return false;
+        }
+    }
+    // Without a failed array, a division by zero throws
+    try {
+        rpn.evaluateColumns(program, &columns[0], rows, &results[0], NULL);
+        threw = false;
+    } catch (const std::exception &) {
+        threw = true;
+    }
+    if (threw != anyFailed) {
+        std::cerr << expr << ", " << rows << " rows: "
+                  << (threw ? "threw" : "did not throw") << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    RPN rpn;
+    bool ok;
+
+    ok = true;
+    for (size_t e = 0; e < sizeof(g_exprs) / sizeof(g_exprs[0]); ++e) {
+        for (size_t r = 0; r < sizeof(g_rows) / sizeof(g_rows[0]); ++r)
+            ok = check(rpn, g_exprs[e], g_rows[r]) && ok;
+    }
+    if (!ok)
+        return 1;
+    std::cout << "columns: ok" << std::endl;
+    return 0;
+}
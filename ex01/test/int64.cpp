@@ -0,0 +1,62 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   int64.cpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:29:35 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 02:29:35 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../RPN.hpp"
+#include <exception>
+#include <iostream>
+#include <string>
+
+// Products at the edges of CheckedInt64, against results computed with
+// Python's unbounded integers; "overflow" means the evaluation throws it
+
+struct Case {
+    const char *expr;
+    const char *expected;
+};
+
+static const Case g_cases[] = {
+    {"0 4611686018427387904 - 2 *", "-9223372036854775808"},
+    {"4611686018427387904 0 2 - *", "-9223372036854775808"},
+    {"4611686018427387904 2 *", "overflow"},
+    {"0 4611686018427387904 - 0 2 - *", "overflow"},
+    {"4294967296 0 2147483648 - *", "-9223372036854775808"},
+    {"4294967296 2147483648 *", "overflow"},
+    {"3037000499 3037000499 *", "9223372030926249001"},
+    {"0 3037000500 - 3037000500 *", "overflow"},
+    {"0 9223372036854775807 - 1 - 1 *", "-9223372036854775808"},
+    {"0 9223372036854775807 - 1 - 0 1 - *", "overflow"},
+    {"0 1 - 0 9223372036854775807 - *", "9223372036854775807"},
+};
+
+int main() {
+    RPN rpn;
+    std::string result;
+    bool ok;
+
+    ok = true;
+    for (size_t i = 0; i < sizeof(g_cases) / sizeof(g_cases[0]); ++i) {
+        try {
+            result = rpn.evaluate(g_cases[i].expr, RPN::CHECKED_INT64);
+        } catch (const std::exception &e) {
+            result = e.what();
+        }
+        if (result != g_cases[i].expected) {
+            std::cerr << g_cases[i].expr << ": " << result << ", expected "
+                      << g_cases[i].expected << std::endl;
+            ok = false;
+        }
+    }
+    if (!ok)
+        return 1;
+    std::cout << "int64: ok" << std::endl;
+    return 0;
+}
@@ -0,0 +1,107 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   jit.cpp                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 03:08:35 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 03:09:38 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+#include "../RPN.hpp"
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// The generated code against evaluate(Program, Bindings&) for every
+// binding in a grid: stacks deeper than the eight register slots, and
+// divisors that are zero for some bindings only, where the native code
+// must bail out instead of dividing
+
+static const char *const g_exprs[] = {
+    "a b c a b c a b c a b c + - * + - + - + - + *",
+    "1 2 3 4 5 6 7 8 a b / + + + + + + + +",
+    "a 1 2 3 4 5 6 7 8 9 c - + * - + - + - b / + -",
+    "a b c a b c a b c a b c a b c / / / / / / / / / / / / / /",
+    "a b - c /",
+    "a b /",
+};
+
+// Values each variable takes; the grid covers every combination
+static const int g_values[] = {-7, -2, -1, 0, 1, 3, 11};
+static const size_t g_valueCount = sizeof(g_values) / sizeof(g_values[0]);
+
+static bool check(const RPN &rpn, const char *expr) {
+    RPN::Program program = rpn.compile(expr);
+    RPN::Jit jit = rpn.jit(program);
+    RPN::Bindings bindings(program);
+    RPN::Jit::Function function;
+    size_t combinations;
+    size_t index;
+    int expected;
+    int native;
+    int result;
+    int status;
+    bool threw;
+
+    function = jit.function();
+    combinations = 1;
+    for (size_t s = 0; s < program.variableCount(); ++s)
+        combinations *= g_valueCount;
+    for (size_t c = 0; c < combinations; ++c) {
+        index = c;
+        for (size_t s = 0; s < program.variableCount(); ++s) {
+            bindings.set(s, g_values[index % g_valueCount]);
+            index /= g_valueCount;
+        }
+        try {
+            expected = rpn.evaluate(program, bindings);
+            threw = false;
+        } catch (const std::exception &) {
+            expected = 0;
+            threw = true;
+        }
+        // Through RPN, which reruns the interpreter after a bailout
+        try {
+            result = rpn.evaluate(jit, bindings);
+            if (threw || result != expected) {
+                std::cerr << expr << ", binding " << c << ": " << result
+                          << ", expected " << expected << std::endl;
+                return false;
+            }
+        } catch (const std::exception &) {
+            if (!threw) {
+                std::cerr << expr << ", binding " << c << ": threw"
+                          << std::endl;
+                return false;
+            }
+        }
+        // The native code alone, where there is any
+        if (!function)
+            continue;
+        native = 0;
+        status = function(bindings.values(), &native);
+        if ((status != 0) != threw || (!threw && native != expected)) {
+            std::cerr << expr << ", binding " << c << ": native " << native
+                      << " status " << status << ", expected " << expected
+                      << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    RPN rpn;
+    bool ok;
+
+    ok = true;
+    for (size_t e = 0; e < sizeof(g_exprs) / sizeof(g_exprs[0]); ++e)
+        ok = check(rpn, g_exprs[e]) && ok;
+    if (!ok)
+        return 1;
+    std::cout << "jit: ok" << std::endl;
+    return 0;
+}
@@ -0,0 +1,70 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FenwickTree.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:03:17 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 01:41:54 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "FenwickTree.hpp"
+
+FenwickTree::FenwickTree() : tree(1, 0), highBit(0) {}
+
+FenwickTree::FenwickTree(const FenwickTree &other)
+    : tree(other.tree), highBit(other.highBit) {}
+
+FenwickTree &FenwickTree::operator=(const FenwickTree &other) {
+  if (this != &other) {
+    tree = other.tree;
+    highBit = other.highBit;
+  }
+  return (*this);
+}
+
+FenwickTree::~FenwickTree() {}
+
+// Every weight starts equal, so node i holds weight * lowbit(i) directly
+void FenwickTree::assign(size_t n, uint32_t weight) {
+  tree.resize(n + 1);
+  tree[0] = 0;
+  for (size_t i = 1; i <= n; ++i)
+    tree[i] = static_cast<uint32_t>(weight * (i & (0 - i)));
+  highBit = 1;
+  while (highBit * 2 <= n)
+    highBit *= 2;
+  if (n == 0)
+    highBit = 0;
+}
+
+void FenwickTree::add(size_t index, uint32_t delta) {
+  for (size_t i = index + 1; i < tree.size(); i += i & (0 - i))
+    tree[i] += delta;
+}
+
+// Sum of weights [0, index]
+size_t FenwickTree::prefix(size_t index) const {
+  size_t sum;
+
+  sum = 0;
+  for (size_t i = index + 1; i > 0; i -= i & (0 - i))
+    sum += tree[i];
+  return (sum);
+}
+
+// Largest k such that weights [0, k) sum to at most target
+size_t FenwickTree::countAtMost(size_t target) const {
+  size_t k;
+
+  k = 0;
+  for (size_t step = highBit; step; step /= 2) {
+    if (k + step < tree.size() && tree[k + step] <= target) {
+      k += step;
+      target -= tree[k];
+    }
+  }
+  return (k);
+}
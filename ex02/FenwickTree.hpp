@@ -0,0 +1,39 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FenwickTree.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:03:17 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 01:41:54 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FENWICKTREE_HPP
+#define FENWICKTREE_HPP
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+// Binary indexed tree over n non-negative weights: point updates, prefix
+// sums and prefix searches in O(log n)
+class FenwickTree {
+public:
+  FenwickTree();
+  FenwickTree(const FenwickTree &other);
+  FenwickTree &operator=(const FenwickTree &other);
+  ~FenwickTree();
+
+  void assign(size_t n, uint32_t weight);
+  void add(size_t index, uint32_t delta);
+  size_t prefix(size_t index) const;
+  size_t countAtMost(size_t target) const;
+
+private:
+  std::vector<uint32_t> tree;
+  size_t highBit;
+};
+
+#endif
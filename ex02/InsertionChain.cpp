@@ -0,0 +1,333 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   InsertionChain.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:03:40 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 02:40:22 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "InsertionChain.hpp"
+#include <algorithm>
+
+static const uint32_t g_none = 0xffffffffu;
+static const uint32_t g_full = 0xffffffffu;
+
+template <class Key>
+InsertionChain<Key>::InsertionChain() : root(0), height(0), total(0) {
+  assign(NULL, NULL, 0, 0);
+}
+
+template <class Key>
+InsertionChain<Key>::InsertionChain(const InsertionChain &other)
+    : keys(other.keys), ids(other.ids), counts(other.counts),
+      next(other.next), nodes(other.nodes), root(other.root),
+      height(other.height), total(other.total) {
+  resetPath();
+}
+
+template <class Key>
+InsertionChain<Key> &
+InsertionChain<Key>::operator=(const InsertionChain &other) {
+  if (this != &other) {
+    keys = other.keys;
+    ids = other.ids;
+    counts = other.counts;
+    next = other.next;
+    nodes = other.nodes;
+    root = other.root;
+    height = other.height;
+    total = other.total;
+    resetPath();
+  }
+  return (*this);
+}
+
+template <class Key>
+InsertionChain<Key>::~InsertionChain() {}
+
+// Loads n elements into half-full leaves and nodes, leaving room for the
+// chain to grow to capacity elements without reallocating
+template <class Key>
+void InsertionChain<Key>::assign(const Key *first, const uint32_t *firstId,
+                                 size_t n, size_t capacity) {
+  size_t leafCount;
+  size_t count;
+  size_t levelBegin;
+  size_t levelEnd;
+  size_t level;
+
+  leafCount = 2 * std::max(n, capacity) / LEAF_SIZE + 2;
+  keys.reserve(leafCount * LEAF_SIZE);
+  ids.reserve(leafCount * LEAF_SIZE);
+  counts.reserve(leafCount);
+  next.reserve(leafCount);
+  keys.clear();
+  ids.clear();
+  counts.clear();
+  next.clear();
+  nodes.clear();
+  nodes.reserve(leafCount / (FANOUT / 4) + 4);
+  for (size_t i = 0; i < n || counts.empty(); i += LEAF_SIZE / 2) {
+    count = std::min(n - i, static_cast<size_t>(LEAF_SIZE / 2));
+    uint32_t leaf = addLeaf();
+    std::copy(first + i, first + i + count, &keys[leaf * LEAF_SIZE]);
+    std::copy(firstId + i, firstId + i + count, &ids[leaf * LEAF_SIZE]);
+    counts[leaf] = static_cast<uint32_t>(count);
+    if (leaf > 0)
+      next[leaf - 1] = leaf;
+  }
+  total = n;
+  height = 0;
+  levelBegin = 0;
+  levelEnd = counts.size();
+  while (levelEnd - levelBegin > 1) {
+    level = nodes.size();
+    for (size_t i = levelBegin; i < levelEnd; i += FANOUT / 2) {
+      nodes.push_back(Node());
+      Node &node = nodes.back();
+      node.count = static_cast<uint32_t>(
+          std::min(levelEnd - i, static_cast<size_t>(FANOUT / 2)));
+      std::fill(node.ends, node.ends + FANOUT, g_full);
+      count = 0;
+      for (uint32_t c = 0; c < node.count; ++c) {
+        node.children[c] = static_cast<uint32_t>(i + c);
+        count += subtreeSize(node.children[c], height);
+        node.ends[c] = static_cast<uint32_t>(count);
+      }
+    }
+    levelBegin = level;
+    levelEnd = nodes.size();
+    ++height;
+  }
+  root = static_cast<uint32_t>(levelBegin);
+  resetPath();
+}
+
+template <class Key>
+size_t InsertionChain<Key>::size() const { return (total); }
+
+// Returns the keys of the leaf holding rank; first is the rank of its
+// first element and count its length
+template <class Key>
+const Key *InsertionChain<Key>::leaf(size_t rank, size_t &first,
+                                     size_t &count) const {
+  uint32_t found;
+
+  found = findLeaf(rank);
+  first = pathFirst[0];
+  count = pathSize[0];
+  return (&keys[found * LEAF_SIZE]);
+}
+
+template <class Key>
+uint32_t InsertionChain<Key>::id(size_t rank) const {
+  uint32_t found;
+
+  found = findLeaf(rank);
+  return (ids[found * LEAF_SIZE + rank - pathFirst[0]]);
+}
+
+template <class Key>
+void InsertionChain<Key>::insert(size_t rank, const Key &key, uint32_t id) {
+  uint32_t split;
+  uint32_t left;
+
+  split = insertInto(root, height, rank, key, id);
+  ++total;
+  if (split != g_none) {
+    left = root;
+    nodes.push_back(Node());
+    Node &node = nodes.back();
+    node.count = 2;
+    node.children[0] = left;
+    node.children[1] = split;
+    std::fill(node.ends, node.ends + FANOUT, g_full);
+    node.ends[1] = static_cast<uint32_t>(total);
+    node.ends[0] = static_cast<uint32_t>(total - subtreeSize(split, height));
+    root = static_cast<uint32_t>(nodes.size() - 1);
+    ++height;
+  }
+  resetPath();
+}
+
+template <class Key>
+void InsertionChain<Key>::copyTo(Key *outKeys, uint32_t *outIds) const {
+  for (uint32_t i = 0; i != g_none; i = next[i]) {
+    outKeys = std::copy(&keys[i * LEAF_SIZE], &keys[i * LEAF_SIZE] + counts[i],
+                        outKeys);
+    outIds = std::copy(&ids[i * LEAF_SIZE], &ids[i * LEAF_SIZE] + counts[i],
+                       outIds);
+  }
+}
+
+template <class Key>
+void InsertionChain<Key>::resetPath() {
+  pathLevel = height;
+  pathNode[height] = root;
+  pathFirst[height] = 0;
+  pathSize[height] = total;
+}
+
+// Descends to the leaf holding rank from the lowest node on the previous
+// path that still covers it. Sizes come from the parents' ends, so only
+// the element itself is read from the leaf.
+template <class Key>
+uint32_t InsertionChain<Key>::findLeaf(size_t rank) const {
+  unsigned level;
+  size_t first;
+  uint32_t c;
+
+  level = pathLevel;
+  while (level < height && rank - pathFirst[level] >= pathSize[level])
+    ++level;
+  first = pathFirst[level];
+  for (; level > 0; --level) {
+    const Node &node = nodes[pathNode[level]];
+    c = findChild(node, static_cast<uint32_t>(rank - first));
+    pathNode[level - 1] = node.children[c];
+    pathSize[level - 1] = node.ends[c];
+    if (c > 0) {
+      pathSize[level - 1] -= node.ends[c - 1];
+      first += node.ends[c - 1];
+    }
+    pathFirst[level - 1] = first;
+  }
+  pathLevel = 0;
+  return (pathNode[0]);
+}
+
+// Inserts below index and returns the new right sibling if index had to
+// split, g_none otherwise
+template <class Key>
+uint32_t InsertionChain<Key>::insertInto(uint32_t index, unsigned level,
+                                         size_t rank, const Key &key,
+                                         uint32_t id) {
+  uint32_t sibling;
+  uint32_t split;
+  uint32_t c;
+  size_t right;
+
+  sibling = g_none;
+  if (level == 0) {
+    if (counts[index] == LEAF_SIZE) {
+      sibling = splitLeaf(index);
+      if (rank > counts[index]) {
+        rank -= counts[index];
+        index = sibling;
+      }
+    }
+    Key *leafKeys = &keys[index * LEAF_SIZE];
+    uint32_t *leafIds = &ids[index * LEAF_SIZE];
+    std::copy_backward(leafKeys + rank, leafKeys + counts[index],
+                       leafKeys + counts[index] + 1);
+    std::copy_backward(leafIds + rank, leafIds + counts[index],
+                       leafIds + counts[index] + 1);
+    leafKeys[rank] = key;
+    leafIds[rank] = id;
+    ++counts[index];
+    return (sibling);
+  }
+  c = std::min(findChild(nodes[index], static_cast<uint32_t>(rank)),
+               nodes[index].count - 1);
+  if (c > 0)
+    rank -= nodes[index].ends[c - 1];
+  split = insertInto(nodes[index].children[c], level - 1, rank, key, id);
+  for (uint32_t i = c; i < nodes[index].count; ++i)
+    ++nodes[index].ends[i];
+  if (split == g_none)
+    return (g_none);
+  right = subtreeSize(split, level - 1);
+  if (nodes[index].count == FANOUT) {
+    sibling = splitNode(index);
+    if (c >= FANOUT / 2) {
+      c -= FANOUT / 2;
+      index = sibling;
+    }
+  }
+  Node &node = nodes[index];
+  std::copy_backward(node.children + c + 1, node.children + node.count,
+                     node.children + node.count + 1);
+  std::copy_backward(node.ends + c, node.ends + node.count,
+                     node.ends + node.count + 1);
+  node.children[c + 1] = split;
+  node.ends[c] -= static_cast<uint32_t>(right);
+  ++node.count;
+  return (sibling);
+}
+
+template <class Key>
+uint32_t InsertionChain<Key>::addLeaf() {
+  keys.resize(keys.size() + LEAF_SIZE);
+  ids.resize(ids.size() + LEAF_SIZE);
+  counts.push_back(0);
+  next.push_back(g_none);
+  return (static_cast<uint32_t>(counts.size() - 1));
+}
+
+template <class Key>
+uint32_t InsertionChain<Key>::splitLeaf(uint32_t index) {
+  uint32_t sibling;
+  size_t half;
+
+  sibling = addLeaf();
+  half = static_cast<size_t>(index) * LEAF_SIZE + LEAF_SIZE / 2;
+  std::copy(&keys[half], &keys[half] + (counts[index] - LEAF_SIZE / 2),
+            &keys[sibling * LEAF_SIZE]);
+  std::copy(&ids[half], &ids[half] + (counts[index] - LEAF_SIZE / 2),
+            &ids[sibling * LEAF_SIZE]);
+  counts[sibling] = counts[index] - LEAF_SIZE / 2;
+  counts[index] = LEAF_SIZE / 2;
+  next[sibling] = next[index];
+  next[index] = sibling;
+  return (sibling);
+}
+
+template <class Key>
+uint32_t InsertionChain<Key>::splitNode(uint32_t index) {
+  uint32_t sibling;
+
+  sibling = static_cast<uint32_t>(nodes.size());
+  nodes.push_back(Node());
+  Node &left = nodes[index];
+  Node &right = nodes[sibling];
+  right.count = left.count - FANOUT / 2;
+  std::copy(left.children + FANOUT / 2, left.children + left.count,
+            right.children);
+  std::fill(right.ends, right.ends + FANOUT, g_full);
+  for (uint32_t c = 0; c < right.count; ++c)
+    right.ends[c] = left.ends[FANOUT / 2 + c] - left.ends[FANOUT / 2 - 1];
+  std::fill(left.ends + FANOUT / 2, left.ends + FANOUT, g_full);
+  left.count = FANOUT / 2;
+  return (sibling);
+}
+
+template <class Key>
+size_t InsertionChain<Key>::subtreeSize(uint32_t index,
+                                        unsigned level) const {
+  if (level == 0)
+    return (counts[index]);
+  return (nodes[index].ends[nodes[index].count - 1]);
+}
+
+// Number of ends at or below offset, i.e. the child holding it. ends is
+// sorted and padded to FANOUT, so this is a fixed-depth binary search
+template <class Key>
+uint32_t InsertionChain<Key>::findChild(const Node &node,
+                                        uint32_t offset) {
+  uint32_t c;
+
+  c = 0;
+  for (uint32_t step = FANOUT / 2; step > 0; step /= 2) {
+    if (node.ends[c + step - 1] <= offset)
+      c += step;
+  }
+  return (c);
+}
+
+// Handles for MergeInsertion's generic path, values for its int path
+template class InsertionChain<uint32_t>;
+template class InsertionChain<int>;
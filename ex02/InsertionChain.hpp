@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   InsertionChain.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:03:40 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 02:40:22 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef INSERTIONCHAIN_HPP
+#define INSERTIONCHAIN_HPP
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+// Sequence of (key, id) elements addressed by rank, kept as a B+ tree
+// whose internal nodes count the elements under each child. A key is what
+// the caller compares by: the value itself, or a handle to it. Reading or
+// inserting at a rank costs O(log n), and an insertion moves at most one
+// leaf's worth of elements. Instantiated for int and uint32_t keys.
+template <class Key> class InsertionChain {
+public:
+  InsertionChain();
+  InsertionChain(const InsertionChain &other);
+  InsertionChain &operator=(const InsertionChain &other);
+  ~InsertionChain();
+
+  void assign(const Key *first, const uint32_t *firstId, size_t n,
+              size_t capacity);
+  size_t size() const;
+  const Key *leaf(size_t rank, size_t &first, size_t &count) const;
+  uint32_t id(size_t rank) const;
+  void insert(size_t rank, const Key &key, uint32_t id);
+  void copyTo(Key *outKeys, uint32_t *outIds) const;
+
+private:
+  enum { LEAF_SIZE = 512, FANOUT = 64, MAX_HEIGHT = 16 };
+
+  // ends[c] counts the elements under children 0..c; unused entries hold
+  // g_full so a child is found by counting the ends at or below an offset
+  struct Node {
+    uint32_t count;
+    uint32_t children[FANOUT];
+    uint32_t ends[FANOUT];
+  };
+
+  // Leaf i holds keys[i * LEAF_SIZE ..] and ids[i * LEAF_SIZE ..], kept
+  // apart so that searching only brings the keys into cache
+  std::vector<Key> keys;
+  std::vector<uint32_t> ids;
+  std::vector<uint32_t> counts;
+  std::vector<uint32_t> next;
+  std::vector<Node> nodes;
+  uint32_t root;
+  unsigned height;
+  size_t total;
+  // Last root-to-leaf descent. Binary search probes mostly land near the
+  // previous one, so lookups restart from the lowest node still covering
+  // the rank instead of the root
+  mutable uint32_t pathNode[MAX_HEIGHT];
+  mutable size_t pathFirst[MAX_HEIGHT];
+  mutable size_t pathSize[MAX_HEIGHT];
+  mutable unsigned pathLevel;
+
+  static uint32_t findChild(const Node &node, uint32_t offset);
+  void resetPath();
+  uint32_t findLeaf(size_t rank) const;
+  uint32_t insertInto(uint32_t index, unsigned level, size_t rank,
+                      const Key &key, uint32_t id);
+  uint32_t addLeaf();
+  uint32_t splitLeaf(uint32_t index);
+  uint32_t splitNode(uint32_t index);
+  size_t subtreeSize(uint32_t index, unsigned level) const;
+};
+
+#endif
@@ -0,0 +1,448 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MergeInsertion.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:44:47 by igngonza          #+#    #+#             */
+/*   Updated: 2026/10/18 03:07:19 by igngonza         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MERGEINSERTION_HPP
+#define MERGEINSERTION_HPP
+
+#include "FenwickTree.hpp"
+#include "InsertionChain.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <stdint.h>
+#include <vector>
+
+// What the chains of MergeInsertion<T> carry for each key: by default a
+// 32-bit handle into the caller's range, so keys that cost more to copy
+// than a handle are compared where they are. A specialization that
+// carries the key itself saves going back to the range on every probe;
+// its Type needs an InsertionChain instantiation.
+template <class T> struct MergeInsertionSlot {
+  typedef uint32_t Type;
+
+  template <class RandomIt> static Type at(RandomIt keys, size_t i) {
+    (void)keys;
+    return (static_cast<Type>(i));
+  }
+  template <class RandomIt>
+  static typename std::iterator_traits<RandomIt>::reference key(RandomIt keys,
+                                                                Type slot) {
+    return (keys[slot]);
+  }
+};
+
+template <> struct MergeInsertionSlot<int> {
+  typedef int Type;
+
+  template <class RandomIt> static Type at(RandomIt keys, size_t i) {
+    return (keys[i]);
+  }
+  template <class RandomIt>
+  static const Type &key(RandomIt keys, const Type &slot) {
+    (void)keys;
+    return (slot);
+  }
+};
+
+// Ford-Johnson merge-insertion sort. Pairs, chains and pending elements
+// are slots (see MergeInsertionSlot), and once the order is known every
+// key is moved to its place by swapping along the cycles of the
+// permutation. A payload range follows the same swaps.
+//
+//     MergeInsertion<std::string> sorter;
+//     sorter.sort(names.begin(), names.end(), records.begin());
+//     sorter.comparisons();    // calls made to compare by that sort
+//
+// Sorting n keys calls compare at most comparisonBound(n) times.
+template <class T, class Compare = std::less<T> > class MergeInsertion {
+public:
+  MergeInsertion();
+  explicit MergeInsertion(const Compare &comp);
+  MergeInsertion(const MergeInsertion &other);
+  MergeInsertion &operator=(const MergeInsertion &other);
+  ~MergeInsertion();
+
+  template <class RandomIt> void sort(RandomIt first, RandomIt last);
+  template <class RandomIt, class PayloadIt>
+  void sort(RandomIt first, RandomIt last, PayloadIt payload);
+  size_t comparisons() const;
+
+  static size_t comparisonBound(size_t n);
+  static std::vector<size_t> insertionOrder(size_t pendingSize);
+
+private:
+  typedef MergeInsertionSlot<T> SlotTraits;
+  typedef typename SlotTraits::Type Slot;
+
+  Compare compare;
+  size_t count;
+
+  // Scratch for one sort. Each recursion level takes its buffers from the
+  // top and releases them on return
+  struct Arena {
+    std::vector<Slot> slots;
+    std::vector<uint32_t> ids;
+    InsertionChain<Slot> chain;
+    FenwickTree partners;
+    std::vector<uint32_t> segmentOf;
+    size_t top;
+  };
+
+  template <class RandomIt>
+  void sortOrder(RandomIt first, RandomIt last, std::vector<uint32_t> &order);
+  template <class It>
+  static void permute(It first, std::vector<uint32_t> &order);
+  template <class RandomIt>
+  bool less(RandomIt keys, const Slot &a, const Slot &b);
+  static size_t arenaSize(size_t n);
+  template <class RandomIt>
+  void sortLevel(RandomIt keys, Slot *slots, uint32_t *ids, size_t n,
+                 Arena &arena);
+  template <class RandomIt>
+  void insertPending(RandomIt keys, Slot *slots, uint32_t *ids,
+                     const uint32_t *chainIds, size_t chainSize,
+                     const Slot *pendingSlots,
+                     const uint32_t *pendingIds, size_t pendingSize,
+                     Arena &arena);
+  template <class RandomIt>
+  size_t binarySearch(RandomIt keys, const InsertionChain<Slot> &chain,
+                      const Slot &slot, size_t end);
+  static std::vector<size_t> jacobsthal(size_t n);
+};
+
+template <class T, class Compare>
+MergeInsertion<T, Compare>::MergeInsertion() : compare(), count(0) {}
+
+template <class T, class Compare>
+MergeInsertion<T, Compare>::MergeInsertion(const Compare &comp)
+    : compare(comp), count(0) {}
+
+template <class T, class Compare>
+MergeInsertion<T, Compare>::MergeInsertion(const MergeInsertion &other)
+    : compare(other.compare), count(other.count) {}
+
+template <class T, class Compare>
+MergeInsertion<T, Compare> &
+MergeInsertion<T, Compare>::operator=(const MergeInsertion &other) {
+  if (this != &other) {
+    compare = other.compare;
+    count = other.count;
+  }
+  return (*this);
+}
+
+template <class T, class Compare>
+MergeInsertion<T, Compare>::~MergeInsertion() {}
+
+template <class T, class Compare>
+template <class RandomIt>
+void MergeInsertion<T, Compare>::sort(RandomIt first, RandomIt last) {
+  std::vector<uint32_t> order;
+
+  sortOrder(first, last, order);
+  permute(first, order);
+}
+
+template <class T, class Compare>
+template <class RandomIt, class PayloadIt>
+void MergeInsertion<T, Compare>::sort(RandomIt first, RandomIt last,
+                                      PayloadIt payload) {
+  std::vector<uint32_t> order;
+
+  sortOrder(first, last, order);
+  std::vector<uint32_t> payloadOrder(order);
+  permute(first, order);
+  permute(payload, payloadOrder);
+}
+
+// Comparisons made by the last sort
+template <class T, class Compare>
+size_t MergeInsertion<T, Compare>::comparisons() const {
+  return (count);
+}
+
+// Ford-Johnson's worst case: the sum of ceil(log2(3k / 4)) for k = 1..n
+template <class T, class Compare>
+size_t MergeInsertion<T, Compare>::comparisonBound(size_t n) {
+  size_t bound;
+  size_t bits;
+
+  bound = 0;
+  bits = 0;
+  for (size_t k = 1; k <= n; ++k) {
+    while ((static_cast<size_t>(4) << bits) < 3 * k)
+      ++bits;
+    bound += bits;
+  }
+  return (bound);
+}
+
+// Order in which pending elements 1..pendingSize-1 are inserted: groups
+// ending at the Jacobsthal numbers, each taken from its end down
+template <class T, class Compare>
+std::vector<size_t>
+MergeInsertion<T, Compare>::insertionOrder(size_t pendingSize) {
+  size_t prevJacob;
+  size_t currentJacob;
+
+  std::vector<size_t> order;
+  if (pendingSize <= 1)
+    return (order);
+  std::vector<size_t> sequence = jacobsthal(pendingSize);
+  prevJacob = 0;
+  for (size_t i = 3; i < sequence.size(); ++i) {
+    currentJacob = std::min(sequence[i] - 1, pendingSize - 1);
+    for (size_t j = currentJacob; j > prevJacob; --j)
+      order.push_back(j);
+    prevJacob = currentJacob;
+    if (currentJacob >= pendingSize - 1)
+      break;
+  }
+  for (size_t j = pendingSize - 1; j > prevJacob && j > 0; --j)
+    order.push_back(j);
+  return (order);
+}
+
+template <class T, class Compare>
+std::vector<size_t> MergeInsertion<T, Compare>::jacobsthal(size_t n) {
+  size_t next;
+
+  std::vector<size_t> sequence;
+  if (n == 0)
+    return (sequence);
+  sequence.push_back(0);
+  sequence.push_back(1);
+  while (true) {
+    next = sequence[sequence.size() - 1] + 2 * sequence[sequence.size() - 2];
+    if (next >= n)
+      break;
+    sequence.push_back(next);
+  }
+  return (sequence);
+}
+
+// order[k] becomes the position in [first, last) of the k-th smallest key
+template <class T, class Compare>
+template <class RandomIt>
+void MergeInsertion<T, Compare>::sortOrder(RandomIt first, RandomIt last,
+                                           std::vector<uint32_t> &order) {
+  Arena arena;
+  size_t n;
+
+  count = 0;
+  n = last - first;
+  if (n > 0xffffffffu)
+    throw std::runtime_error("too many elements");
+  order.resize(n);
+  for (size_t i = 0; i < n; ++i)
+    order[i] = static_cast<uint32_t>(i);
+  if (n <= 1)
+    return;
+  std::vector<Slot> slots(n);
+  for (size_t i = 0; i < n; ++i)
+    slots[i] = SlotTraits::at(first, i);
+  arena.slots.resize(arenaSize(n));
+  arena.ids.resize(arena.slots.size());
+  arena.top = 0;
+  sortLevel(first, &slots[0], &order[0], n, arena);
+}
+
+// Moves first[order[k]] to first[k], swapping each element once along the
+// cycle it belongs to. order is left as the identity
+template <class T, class Compare>
+template <class It>
+void MergeInsertion<T, Compare>::permute(It first,
+                                         std::vector<uint32_t> &order) {
+  size_t j;
+  uint32_t from;
+
+  for (size_t i = 0; i < order.size(); ++i) {
+    for (j = i; order[j] != i; j = from) {
+      from = order[j];
+      std::iter_swap(first + j, first + from);
+      order[j] = static_cast<uint32_t>(j);
+    }
+    order[j] = static_cast<uint32_t>(j);
+  }
+}
+
+template <class T, class Compare>
+template <class RandomIt>
+bool MergeInsertion<T, Compare>::less(RandomIt keys, const Slot &a,
+                                      const Slot &b) {
+  ++count;
+  return (compare(SlotTraits::key(keys, a), SlotTraits::key(keys, b)));
+}
+
+// Arena entries needed to sort n elements: the pairs' larger and smaller
+// halves stay live while the larger halves are sorted, and the reordered
+// pending elements are taken once that recursion has returned
+template <class T, class Compare>
+size_t MergeInsertion<T, Compare>::arenaSize(size_t n) {
+  size_t half;
+
+  if (n <= 1)
+    return (0);
+  half = n / 2;
+  return (2 * half + std::max(half + 1, arenaSize(half)));
+}
+
+// Sorts slots[0..n) in place, moving ids[] along with them. Ids only
+// identify an element within this level: the level below is handed the
+// pair numbers as ids, so its sorted order maps straight back to pairs.
+template <class T, class Compare>
+template <class RandomIt>
+void MergeInsertion<T, Compare>::sortLevel(RandomIt keys, Slot *slots,
+                                           uint32_t *ids, size_t n,
+                                           Arena &arena) {
+  size_t larger;
+  size_t half;
+  size_t base;
+  size_t pendingSize;
+  uint32_t pair;
+
+  if (n <= 1)
+    return;
+  half = n / 2;
+  base = arena.top;
+  Slot *chainSlots = &arena.slots[base];
+  uint32_t *chainIds = &arena.ids[base];
+  Slot *smallSlots = chainSlots + half;
+  uint32_t *smallAt = chainIds + half;
+  arena.top += 2 * half;
+  for (size_t i = 0; i < half; ++i) {
+    larger = less(keys, slots[2 * i + 1], slots[2 * i]) ? 2 * i : 2 * i + 1;
+    chainSlots[i] = slots[larger];
+    chainIds[i] = static_cast<uint32_t>(i);
+    smallSlots[i] = slots[larger ^ 1];
+    smallAt[i] = static_cast<uint32_t>(larger ^ 1);
+  }
+  sortLevel(keys, chainSlots, chainIds, half, arena);
+  Slot *pendingSlots = &arena.slots[arena.top];
+  uint32_t *pendingIds = &arena.ids[arena.top];
+  for (size_t i = 0; i < half; ++i) {
+    pair = chainIds[i];
+    pendingSlots[i] = smallSlots[pair];
+    pendingIds[i] = ids[smallAt[pair]];
+    chainIds[i] = ids[smallAt[pair] ^ 1];
+  }
+  pendingSize = half;
+  if (n % 2) {
+    pendingSlots[half] = slots[n - 1];
+    pendingIds[half] = ids[n - 1];
+    ++pendingSize;
+  }
+  // The first pending element pairs with the smallest of the chain
+  slots[0] = pendingSlots[0];
+  ids[0] = pendingIds[0];
+  std::copy(chainSlots, chainSlots + half, slots + 1);
+  std::copy(chainIds, chainIds + half, ids + 1);
+  insertPending(keys, slots, ids, chainIds, half, pendingSlots,
+                pendingIds, pendingSize, arena);
+  arena.top = base;
+}
+
+// slots/ids hold the first pending element followed by the chain;
+// pending[i] for i >= 1 is inserted before its partner, chain[i].
+// Segment g of the result is the pending elements that landed just before
+// chain[g] followed by chain[g] itself, so the partner's rank is a prefix
+// sum of segment sizes. Segment chainSize, after the whole chain, can only
+// hold the straggler and is not counted.
+//
+// Inside the chain an element is named by its place in this level: j for
+// chain[j] and chainSize + i for pending[i]. The element a new one lands
+// in front of then tells its segment.
+template <class T, class Compare>
+template <class RandomIt>
+void MergeInsertion<T, Compare>::insertPending(
+    RandomIt keys, Slot *slots, uint32_t *ids, const uint32_t *chainIds,
+    size_t chainSize, const Slot *pendingSlots,
+    const uint32_t *pendingIds, size_t pendingSize, Arena &arena) {
+  InsertionChain<Slot> &chain = arena.chain;
+  FenwickTree &partners = arena.partners;
+  std::vector<uint32_t> &segmentOf = arena.segmentOf;
+  size_t pendingIndex;
+  size_t pairPosition;
+  size_t pos;
+  uint32_t next;
+
+  if (pendingSize <= 1)
+    return;
+  ids[0] = static_cast<uint32_t>(chainSize);
+  for (size_t i = 0; i < chainSize; ++i)
+    ids[i + 1] = static_cast<uint32_t>(i);
+  chain.assign(slots, ids, chainSize + 1, chainSize + pendingSize);
+  partners.assign(chainSize, 1);
+  partners.add(0, 1);
+  segmentOf.resize(pendingSize);
+  segmentOf[0] = 0;
+  std::vector<size_t> order = insertionOrder(pendingSize);
+  for (size_t i = 0; i < order.size(); ++i) {
+    pendingIndex = order[i];
+    // Straggler has no pair in the chain — search the entire result
+    if (pendingIndex < chainSize)
+      pairPosition = partners.prefix(pendingIndex) - 1;
+    else
+      pairPosition = chain.size();
+    pos = binarySearch(keys, chain, pendingSlots[pendingIndex],
+                       pairPosition);
+    if (pos == chain.size())
+      segmentOf[pendingIndex] = static_cast<uint32_t>(chainSize);
+    else {
+      next = chain.id(pos);
+      segmentOf[pendingIndex] =
+          next < chainSize ? next : segmentOf[next - chainSize];
+    }
+    chain.insert(pos, pendingSlots[pendingIndex],
+                 static_cast<uint32_t>(chainSize + pendingIndex));
+    if (segmentOf[pendingIndex] < chainSize)
+      partners.add(segmentOf[pendingIndex], 1);
+  }
+  chain.copyTo(slots, ids);
+  for (size_t i = 0; i < chainSize + pendingSize; ++i)
+    ids[i] = ids[i] < chainSize ? chainIds[ids[i]]
+                                : pendingIds[ids[i] - chainSize];
+}
+
+// Probes that fall in the leaf of the previous probe skip the descent
+template <class T, class Compare>
+template <class RandomIt>
+size_t MergeInsertion<T, Compare>::binarySearch(
+    RandomIt keys, const InsertionChain<Slot> &chain, const Slot &slot,
+    size_t end) {
+  const Slot *leaf;
+  size_t first;
+  size_t leafSize;
+  size_t left;
+  size_t right;
+  size_t mid;
+
+  leaf = NULL;
+  first = 0;
+  leafSize = 0;
+  left = 0;
+  right = end;
+  while (left < right) {
+    mid = left + (right - left) / 2;
+    if (mid - first >= leafSize)
+      leaf = chain.leaf(mid, first, leafSize);
+    if (less(keys, leaf[mid - first], slot))
+      left = mid + 1;
+    else
+      right = mid;
+  }
+  return (left);
+}
+
+#endif
@@ -6,7 +6,7 @@
 /*   By: igngonza <igngonza@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2026/02/11 11:59:26 by igngonza          #+#    #+#             */
-/*   Updated: 2026/03/04 14:01:34 by igngonza         ###   ########.fr       */
+/*   Updated: 2026/10/18 03:07:19 by igngonza         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -37,11 +37,6 @@ PmergeMe &PmergeMe::operator=(const PmergeMe &other) {
 
 PmergeMe::~PmergeMe() {}
 
-bool PmergeMe::compareVector(int a, int b) {
-  comparisonCountVector++;
-  return (a < b);
-}
-
 bool PmergeMe::compareDeque(int a, int b) {
   comparisonCountDeque++;
   return (a < b);
@@ -107,173 +102,14 @@ void PmergeMe::sort(int argc, char **argv) {
 }
 
 std::vector<int> PmergeMe::sortWithVector(std::vector<int> &input) {
-  if (input.size() <= 1)
-    return (input);
-  std::vector<std::pair<int, size_t> > indexedInput;
-  for (size_t i = 0; i < input.size(); ++i) {
-    indexedInput.push_back(std::make_pair(input[i], i));
-  }
-  std::vector<std::pair<int, size_t> > sortedIndexed =
-      sortWithIndex(indexedInput);
-  std::vector<int> result;
-  for (size_t i = 0; i < sortedIndexed.size(); ++i) {
-    result.push_back(sortedIndexed[i].first);
-  }
-  return (result);
-}
-
-std::vector<std::pair<int, size_t> >
-PmergeMe::sortWithIndex(std::vector<std::pair<int, size_t> > &input) {
-  bool hasStraggler;
-
-  if (input.size() <= 1)
-    return (input);
-  std::vector<std::pair<std::pair<int, size_t>, std::pair<int, size_t> > >
-      pairs;
-  std::pair<int, size_t> straggler = std::make_pair(-1, 0);
-  hasStraggler = false;
-  for (size_t i = 0; i < input.size(); i += 2) {
-    if (i + 1 < input.size()) {
-      if (compareVector(input[i + 1].first, input[i].first))
-        pairs.push_back(std::make_pair(input[i], input[i + 1]));
-      else
-        pairs.push_back(std::make_pair(input[i + 1], input[i]));
-    } else {
-      straggler = input[i];
-      hasStraggler = true;
-    }
-  }
-  std::vector<std::pair<int, size_t> > largerElements;
-  for (size_t i = 0; i < pairs.size(); ++i) {
-    largerElements.push_back(pairs[i].first);
-  }
-  // recursive call to sort larger elements
-  std::vector<std::pair<int, size_t> > mainChain =
-      sortWithIndex(largerElements);
-  std::vector<std::pair<int, size_t> > pending;
-  for (size_t i = 0; i < pairs.size(); ++i) {
-    pending.push_back(pairs[i].second);
-  }
-  // reorder pending to have the same order of initial pairs
-  std::vector<std::pair<int, size_t> > reorderedPending;
-  for (size_t i = 0; i < mainChain.size(); ++i) {
-    for (size_t j = 0; j < largerElements.size(); ++j) {
-      if (largerElements[j].second == mainChain[i].second) {
-        reorderedPending.push_back(pending[j]);
-        break;
-      }
-    }
-  }
-  if (hasStraggler)
-    reorderedPending.push_back(straggler);
-  std::vector<std::pair<int, size_t> > result =
-      insertPendingWithIndex(mainChain, reorderedPending);
-  return (result);
-}
+  MergeInsertion<int> sorter;
 
-std::vector<std::pair<int, size_t> > PmergeMe::insertPendingWithIndex(
-    std::vector<std::pair<int, size_t> > &mainChain,
-    std::vector<std::pair<int, size_t> > &pending) {
-  size_t pendingIndex;
-  size_t pairPosition;
-  size_t pos;
-
-  if (pending.empty())
-    return (mainChain);
-  std::vector<std::pair<int, size_t> > result = mainChain;
-  std::vector<size_t> mainChainPositions(mainChain.size());
-  for (size_t i = 0; i < mainChain.size(); ++i)
-    mainChainPositions[i] = i;
-  result.insert(result.begin(), pending[0]);
-  for (size_t i = 0; i < mainChainPositions.size(); ++i)
-    mainChainPositions[i]++;
-  if (pending.size() == 1)
-    return (result);
-  std::vector<size_t> insertionOrder = buildInsertionOrder(pending.size());
-  for (size_t i = 0; i < insertionOrder.size(); ++i) {
-    pendingIndex = insertionOrder[i];
-    std::pair<int, size_t> valueToInsert = pending[pendingIndex];
-    // Straggler has no pair in mainChain — search the entire result
-    if (pendingIndex < mainChainPositions.size())
-      pairPosition = mainChainPositions[pendingIndex];
-    else
-      pairPosition = result.size();
-    pos = binarySearchWithIndex(result, valueToInsert.first, pairPosition,
-                                pairPosition);
-    result.insert(result.begin() + pos, valueToInsert);
-    for (size_t j = 0; j < mainChainPositions.size(); ++j) {
-      if (mainChainPositions[j] >= pos)
-        mainChainPositions[j]++;
-    }
-  }
+  std::vector<int> result(input);
+  sorter.sort(result.begin(), result.end());
+  comparisonCountVector = sorter.comparisons();
   return (result);
 }
 
-std::vector<size_t> PmergeMe::generateJacobsthalSequence(size_t n) {
-  size_t next;
-
-  std::vector<size_t> jacobsthal;
-  if (n == 0)
-    return (jacobsthal);
-  jacobsthal.push_back(0);
-  jacobsthal.push_back(1);
-  while (true) {
-    next = jacobsthal[jacobsthal.size() - 1] +
-           2 * jacobsthal[jacobsthal.size() - 2];
-    if (next >= n)
-      break;
-    jacobsthal.push_back(next);
-  }
-  return (jacobsthal);
-}
-
-std::vector<size_t> PmergeMe::buildInsertionOrder(size_t pendingSize) {
-  size_t prevJacob;
-  size_t currentJacob;
-
-  std::vector<size_t> order;
-  if (pendingSize <= 1)
-    return (order);
-  std::vector<size_t> jacobsthal = generateJacobsthalSequence(pendingSize);
-  prevJacob = 0;
-  for (size_t i = 3; i < jacobsthal.size(); ++i) {
-    currentJacob = std::min(jacobsthal[i] - 1, pendingSize - 1);
-    for (size_t j = currentJacob; j > prevJacob; --j) {
-      order.push_back(j);
-    }
-    prevJacob = currentJacob;
-    if (currentJacob >= pendingSize - 1)
-      break;
-  }
-  for (size_t j = pendingSize - 1; j > prevJacob && j > 0; --j) {
-    order.push_back(j);
-  }
-  return (order);
-}
-
-size_t
-PmergeMe::binarySearchWithIndex(const std::vector<std::pair<int, size_t> > &arr,
-                                int value, size_t end, size_t pairPos) {
-  size_t left;
-  size_t right;
-  size_t mid;
-
-  left = 0;
-  right = std::min(end, arr.size());
-  while (left < right) {
-    mid = left + (right - left) / 2;
-    if (mid == pairPos)
-      right = mid;
-    else {
-      if (compareVector(arr[mid].first, value))
-        left = mid + 1;
-      else
-        right = mid;
-    }
-  }
-  return (left);
-}
-
 void PmergeMe::validateInput(const std::string &str) {
   long num;
 
@@ -334,6 +170,7 @@ std::deque<int> PmergeMe::sortWithDeque(std::deque<int> &input) {
 std::deque<std::pair<int, size_t> >
 PmergeMe::sortWithIndexDeque(std::deque<std::pair<int, size_t> > &input) {
   bool hasStraggler;
+  size_t pair;
 
   if (input.size() <= 1)
     return (input);
@@ -351,23 +188,18 @@ PmergeMe::sortWithIndexDeque(std::deque<std::pair<int, size_t> > &input) {
       hasStraggler = true;
     }
   }
+  // The larger elements carry their pair number through the recursion, so
+  // the sorted chain says directly which pending element goes with it
   std::deque<std::pair<int, size_t> > largerElements;
   for (size_t i = 0; i < pairs.size(); ++i)
-    largerElements.push_back(pairs[i].first);
-  // Recursively sort larger elements
+    largerElements.push_back(std::make_pair(pairs[i].first.first, i));
   std::deque<std::pair<int, size_t> > mainChain =
       sortWithIndexDeque(largerElements);
-  std::deque<std::pair<int, size_t> > pending;
-  for (size_t i = 0; i < pairs.size(); ++i)
-    pending.push_back(pairs[i].second);
   std::deque<std::pair<int, size_t> > reorderedPending;
   for (size_t i = 0; i < mainChain.size(); ++i) {
-    for (size_t j = 0; j < largerElements.size(); ++j) {
-      if (largerElements[j].second == mainChain[i].second) {
-        reorderedPending.push_back(pending[j]);
-        break;
-      }
-    }
+    pair = mainChain[i].second;
+    reorderedPending.push_back(pairs[pair].second);
+    mainChain[i].second = pairs[pair].first.second;
   }
   if (hasStraggler)
     reorderedPending.push_back(straggler);
@@ -382,34 +214,34 @@ std::deque<std::pair<int, size_t> > PmergeMe::insertPendingWithIndexDeque(
   size_t pendingIndex;
   size_t pairPosition;
   size_t pos;
+  size_t segment;
 
   if (pending.empty())
     return (mainChain);
   std::deque<std::pair<int, size_t> > result = mainChain;
-  std::vector<size_t> mainChainPositions(mainChain.size());
-  for (size_t i = 0; i < mainChain.size(); ++i)
-    mainChainPositions[i] = i;
+  // Partner ranks as in insertPending
+  FenwickTree partners;
+  partners.assign(mainChain.size(), 1);
+  partners.add(0, 1);
   result.insert(result.begin(), pending[0]);
-  for (size_t i = 0; i < mainChainPositions.size(); ++i)
-    mainChainPositions[i]++;
   if (pending.size() == 1)
     return (result);
-  std::vector<size_t> insertionOrder = buildInsertionOrder(pending.size());
+  std::vector<size_t> insertionOrder =
+      MergeInsertion<int>::insertionOrder(pending.size());
   for (size_t i = 0; i < insertionOrder.size(); ++i) {
     pendingIndex = insertionOrder[i];
     std::pair<int, size_t> valueToInsert = pending[pendingIndex];
     // Straggler has no pair in mainChain — search the entire result
-    if (pendingIndex < mainChainPositions.size())
-      pairPosition = mainChainPositions[pendingIndex];
+    if (pendingIndex < mainChain.size())
+      pairPosition = partners.prefix(pendingIndex) - 1;
     else
       pairPosition = result.size();
     pos = binarySearchWithIndexDeque(result, valueToInsert.first, pairPosition,
                                      pairPosition);
     result.insert(result.begin() + pos, valueToInsert);
-    for (size_t j = 0; j < mainChainPositions.size(); ++j) {
-      if (mainChainPositions[j] >= pos)
-        mainChainPositions[j]++;
-    }
+    segment = partners.countAtMost(pos);
+    if (segment < mainChain.size())
+      partners.add(segment, 1);
   }
   return (result);
 }